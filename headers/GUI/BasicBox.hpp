@@ -270,6 +270,14 @@ class BasicBox : public QGraphicsObject
      */
     void setCrossedExtremity(BoxExtremity extremity);
 
+    /*!
+     * \brief Moves the progress bar to the current position of the box
+     * and repaints only the band between its previous and its new position.
+     *
+     * \param progress : the position of the box read from the execution state of the frame
+     */
+    void updateProgressBar(float progress);
+
     /*!
      * \brief Determines if the box has a trigger point at a specific extremity.
      *
@@ -726,6 +734,7 @@ class BasicBox : public QGraphicsObject
     MaquetteScene * _scene{};                                                     //!< The scene containing box.
     bool _shift;                                                                //!< State of Shift Key.
     bool _playing;                                                              //!< State of playing.
+    float _progress;                                                            //!< Position of the progress bar while playing (between 0 and 1).
     bool _recording;                                                            //!< State of recording.
     bool _mute;                                                                 //!< State of mute.    
     bool _loop;
@@ -50,6 +50,8 @@
 #include <QWidget>
 #include <QPointF>
 #include <QPixmap>
+#include <QPainterPath>
+#include <QTimer>
 #include <QCursor>
 #include <QKeyEvent>
 
@@ -58,6 +60,7 @@
 #include <vector>
 #include <string>
 #include <utility>
+#include "Engine.h"
 
 class QTabWidget;
 class QGridLayout;
@@ -107,12 +110,12 @@ class CurveWidget : public QWidget
      *
      * \return if curves were set correctly
      */
-    void setAttributes(unsigned int boxID, const std::string &address, unsigned int argPosition, const std::vector<float> &values, unsigned int sampleRate,
+    void setAttributes(unsigned int boxID, const std::string &address, unsigned int argPosition, const CurveSamples &values, unsigned int sampleRate,
                        bool redundancy, bool show, bool interpolate, const std::vector<std::string> &argType, const std::vector<float> &xPercents, const std::vector<float> &yValues,
                        const std::vector<short> &sectionType, const std::vector<float> &coeff);
 
     void setAttributes(AbstractCurve *abCurve);
-    void setAttributes(unsigned int boxID, const std::string &address, unsigned int argPosition, const std::vector<float> &values, unsigned int sampleRate,
+    void setAttributes(unsigned int boxID, const std::string &address, unsigned int argPosition, const CurveSamples &values, unsigned int sampleRate,
                        bool redundancy, bool show, bool interpolate, const std::vector<std::string> &argType, const std::vector<float> &xPercents, const std::vector<float> &yValues,
                        const std::vector<short> &sectionType, const std::vector<float> &coeff,const float minY,
                        const float maxY);
@@ -214,6 +217,35 @@ class CurveWidget : public QWidget
      */
     bool curveChanged();
 
+    /*!
+     * \brief Gets the sections of the curve from the breakpoints, as the Engines expect them.
+     */
+    void breakpointsToSections(std::vector<float> &xPercents, std::vector<float> &yValues, std::vector<short> &sectionType, std::vector<float> &coeff);
+
+    /*!
+     * \brief Builds the path drawing the curve with at most a minimum and a maximum value by pixel column.
+     */
+    void updateCurvePath();
+
+    /*!
+     * \brief Samples the curve locally from the breakpoints so it can be drawn without the Engines
+     * (only if the Engines sample the curves the same way : the curve is then redrawn at each commit).
+     */
+    void previewCurve();
+
+    /*!
+     * \brief Called while breakpoints are dragged : previews the curve and sends it to the Engines at a throttled rate.
+     */
+    void curveEdited();
+
+  private slots:
+    /*!
+     * \brief Sends the previewed curve to the Engines.
+     */
+    void commitCurve();
+
+  private:
+
     AbstractCurve *_abstract;
 
     float _movingBreakpointX; //!< Moved break point x coordinate.
@@ -234,6 +266,9 @@ class CurveWidget : public QWidget
     float _minY;
     float _maxY;
     float _xAxisPos;    
+    QPainterPath _curvePath;  //!< Decimated curve in widget coordinates.
+    bool _curvePathOutdated;  //!< True if the samples or the scales changed since the path was built.
+    QTimer _commitTimer;      //!< Throttles the commits to the Engines while dragging.
     QRectF *_minYTextRect;
     QRectF *_maxYTextRect;
 
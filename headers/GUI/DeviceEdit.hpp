@@ -13,6 +13,7 @@
 #include <QHostAddress>
 #include <QFileDialog>
 #include <QRadioButton>
+#include <QTimer>
 #include <NetworkUpdater.h>
 
 class MaquetteScene;
@@ -26,7 +27,6 @@ class DeviceEdit : public QDialog
 {
   Q_OBJECT
 
-		friend class NetworkUpdater;
   public:
     DeviceEdit(QWidget *parent);
     ~DeviceEdit();
@@ -41,6 +41,13 @@ class DeviceEdit : public QDialog
                     _midiDevicesBox.currentText().toStdString();
     }
 
+    /*!
+     * \brief Asks the NetworkUpdater thread to rebuild the namespace of a device
+     * (namespaceRebuilt is emitted when done, namespaceRebuildFailed if it failed or was cancelled).
+     * A background rebuild doesn't disable the tree.
+     */
+    void rebuildNamespace(QString deviceName, bool updateBoxes, bool background = false);
+
   public slots:
     void edit(QString name);
     void edit();
@@ -64,10 +71,24 @@ class DeviceEdit : public QDialog
 	void newDeviceAdded(QString);
 	void namespaceLoaded(QString);
 	
+	void namespaceRebuilt(QString deviceName, bool updateBoxes);
+	void namespaceRebuildFailed(QString deviceName);
+	void progress(QString step);
+
 	void disableTree();
 	void enableTree();
 
+	void updateRequested(NetworkUpdate request, unsigned int requestId);
+	void rebuildRequested(QString deviceName, bool updateBoxes, bool background, unsigned int requestId);
+
+  private slots:
+    void startUpdate();
+    void requestStarted(unsigned int requestId);
+    void requestFinished(unsigned int requestId);
+    void requestTimedOut(unsigned int requestId);
+
   private:
+    static const int REQUEST_TIMEOUT = 10000;   //!< The time (in ms) to wait for each device before giving up (counted from the start of its request).
 
     bool _changed;
     bool _nameChanged;
@@ -113,7 +134,10 @@ class DeviceEdit : public QDialog
     QRadioButton _midiIn{"Input", this};
     QRadioButton _midiOut{"Output", this};
 
-    NetworkUpdater updater{this};
+    NetworkUpdater updater;
+    unsigned int _lastRequestId = 0;
+    QMap<unsigned int, QTimer *> _requestTimers; //!< To notice the requests taking too long (one per request).
+    unsigned int createRequestTimer();
     void setOSCLayout();
     void setMinuitLayout();
     void setMidiLayout();
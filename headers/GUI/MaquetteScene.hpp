@@ -437,6 +437,19 @@ class MaquetteScene : public QGraphicsScene
      * \return the box progress ratio.
      */
     float getPosition(unsigned int boxID);
+
+    /*!
+     * \brief Gets the last execution state published by the engine.
+     * The playing thread reads it once per frame and passes it to updatePlayingBoxes and updateProgressBar.
+     *
+     * \return the execution state, valid until the next call.
+     */
+    const ExecutionState &getExecutionState();
+
+    /*!
+     * \brief Processes the scheduler notifications queued since the last frame.
+     */
+    void processExecutionEvents();
     
     /*!
      * \brief Gets the curent time offset.
@@ -484,8 +497,9 @@ class MaquetteScene : public QGraphicsScene
      * \brief Saves the current composition into a file.
      *
      * \param fileName : the file to save current composition into
+     * \return false if a device was refreshing its namespace (nothing is saved)
      */
-    void save(const std::string &fileName);
+    bool save(const std::string &fileName);
 
     /*!
      * \brief Loads a file into a new composition.
@@ -500,7 +514,7 @@ class MaquetteScene : public QGraphicsScene
      * \return the playing state
      */
     bool playing();
-    inline std::map<unsigned int, BasicBox*> getPlayingBoxes(){return _playingBoxes;}
+    inline const std::map<unsigned int, BasicBox*> &getPlayingBoxes() const {return _playingBoxes;}
 
     /*!
      * \brief Determines the paused state.
@@ -510,9 +524,16 @@ class MaquetteScene : public QGraphicsScene
     bool paused();
 
     /*!
-     * \brief Updates the boxes currently playing.
+     * \brief Updates the progress bar of the boxes currently playing.
+     *
+     * \param state : the execution state of the current frame
+     */
+    void updatePlayingBoxes(const ExecutionState &state);
+
+    /*!
+     * \brief Determines if the scene is shown by a visible and not minimized view.
      */
-    void updatePlayingBoxes();
+    bool isDisplayed() const;
 
     /*!
      * \brief Set the stored playing state of a box.
@@ -552,6 +573,7 @@ class MaquetteScene : public QGraphicsScene
     inline float
     zoom(){ return _view->zoom(); }
     void updateProgressBar();
+    void updateProgressBar(const ExecutionState &state);
     void setAccelerationFactor(double value, unsigned int boxID = ROOT_BOX_ID);
 
     float getMaxSceneWidth();
@@ -667,6 +689,11 @@ protected:
      * \brief Stops playing the composition.
      */
     void stopOrPause();
+
+    /*!
+     * \brief Pauses the composition if it is playing or resumes it if it is paused.
+     */
+    void pauseOrResume();
     void stopAndGoToStart();
     void stopAndGoToTimeOffset(unsigned int timeOffset);
     void stopAndGoToCurrentTime();
@@ -679,6 +706,15 @@ protected:
     void enableCurveEdition();
 
   private:
+    /*!
+     * \brief Computes the coordinates of a box relative to its mother.
+     *
+     * \param boxID : the box
+     * \param coord : the coordinates to fill
+     * \return false if the box doesn't exist
+     */
+    bool boxCoords(unsigned int boxID, Coords &coord);
+
     /*!
      * \brief Makes name sequential.
      * \param name : the box name
@@ -53,6 +53,9 @@
 #include "DeviceEdit.hpp"
 #include <QPair>
 #include <QMap>
+#include <QHash>
+#include <unordered_map>
+#include <unordered_set>
 
 using std::vector;
 using std::string;
@@ -62,7 +65,8 @@ using std::map;
 enum { DeviceNode = QTreeWidgetItem::UserType + 1, NodeNoNamespaceType = QTreeWidgetItem::UserType + 2,
        LeaveType = QTreeWidgetItem::UserType + 3, AttributeType = QTreeWidgetItem::UserType + 4,
        OSCNamespace = QTreeWidgetItem::UserType + 5, OSCNode = QTreeWidgetItem::UserType + 6, addOSCNode = QTreeWidgetItem::UserType + 7,
-       MessageType = QTreeWidgetItem::UserType + 8, addDeviceNode = QTreeWidgetItem::UserType + 9};
+       MessageType = QTreeWidgetItem::UserType + 8, addDeviceNode = QTreeWidgetItem::UserType + 9,
+       PlaceholderType = QTreeWidgetItem::UserType + 10};
 
 class NetworkTreeItem;
 class NetworkTree : public QTreeWidget
@@ -99,11 +103,11 @@ class NetworkTree : public QTreeWidget
 
     QList<std::string> getAddressList();
     /*!
-     * \brief Gets the absolute address of an item in the snapshot tree.
+     * \brief Gets the item of an absolute address, exploring the items along the address if needed.
      *
-     * \param item : the item to get address for
+     * \param address : the address to get the item for
      */
-    QTreeWidgetItem *getItemFromAddress(string address) const;
+    QTreeWidgetItem *getItemFromAddress(string address);
 
     /*!
      * \brief Used for loading. To get tree items, and parsed messages from a string name (given by the engine).
@@ -431,7 +435,31 @@ class NetworkTree : public QTreeWidget
     void deviceUpdated(QTreeWidgetItem* item, bool updateBoxes);
 
   private:
-    void treeRecursiveExploration(QTreeWidgetItem *curItem, bool conflict);
+    /*!
+     * \brief Creates the items of the children of an item from the Engine namespace.
+     *
+     * The children which are not leaves get a placeholder child and are explored when expanded or searched.
+     *
+     * \param curItem : the item to explore.
+     * \param recursive : true to explore all the items below too.
+     */
+    void exploreItem(QTreeWidgetItem *curItem, bool recursive = false);
+
+    /*!
+     * \brief Creates the item of a child of an explored item.
+     *
+     * \param explored : true if the children of the node are created too, else a placeholder is added.
+     * \return the new item or nullptr if it was filtered.
+     */
+    QTreeWidgetItem *createChildItem(QTreeWidgetItem *curItem, const NamespaceNode &node, bool explored = false);
+
+    /*!
+     * \brief Updates the explored items below an item from the current namespace :
+     * only the items which disappeared are removed and only the new ones are created.
+     */
+    void mergeItemChildren(QTreeWidgetItem *curItem);
+    void addPlaceholder(QTreeWidgetItem *item);
+    bool hasPlaceholder(QTreeWidgetItem *item) const;
     void createOSCBranch(QTreeWidgetItem *curItem);
     QTreeWidgetItem *addADeviceNode();
 
@@ -517,7 +545,35 @@ class NetworkTree : public QTreeWidget
     void execClickAction(QTreeWidgetItem *curItem, QList<QTreeWidgetItem *> items, int column);
     void unselectAll();
 
-    QMap<QTreeWidgetItem *, string> _addressMap;
+    /*!
+     * \brief Indexes the absolute address of an item (replacing the item previously indexed at this address).
+     */
+    void indexAddress(QTreeWidgetItem *item, const string &address);
+
+    /*!
+     * \brief Removes an item and all its children from the address index (before they are deleted or taken).
+     */
+    void unindexItems(QTreeWidgetItem *item, bool withItem = true);
+
+    /*!
+     * \brief Indexes again an item and all its children after a rename.
+     */
+    void reindexItems(QTreeWidgetItem *item);
+
+    /*!
+     * \brief What is needed to restore the tree once the namespace of a device is rebuilt.
+     */
+    class NamespaceRefresh {
+      public:
+        std::vector<std::string> expandedAddresses;
+        std::unordered_set<std::string> previousAddresses;
+        bool learning = false;
+        bool revalidation = false;                  // the items were created from the namespace cache and are kept
+    };
+    std::map<std::string, NamespaceRefresh> _pendingRefreshes;
+
+    QHash<QTreeWidgetItem *, string> _addressMap;                       // item -> address
+    std::unordered_map<string, QTreeWidgetItem *> _itemsMap;            // address -> item
     QList<QTreeWidgetItem*> _nodesWithSelectedChildren;
     QMap<QTreeWidgetItem *, Data> _assignedItems;    
     QList<QTreeWidgetItem*> _nodesWithSomeChildrenAssigned;
@@ -542,14 +598,37 @@ class NetworkTree : public QTreeWidget
 
     void disableLearningForEveryDevice();
     void removeOSCMessage(QTreeWidgetItem* item);
-    void setNewItemProperties(NetworkTreeItem* curItem);
+    bool setNewItemProperties(NetworkTreeItem* curItem, const NamespaceNode& node);
 public slots:
+    /*!
+      * \brief Explores an item when it is expanded for the first time.
+      */
+    void exploreExpandedItem(QTreeWidgetItem *item);
+
     /*!
       * \brief Rebuild the networkTree under the item (or currentItem by default), after asking the engine to refresh its namespace.
+      * The namespace is refreshed by the updater thread of the DeviceEdit : the items stay until finishItemNamespaceRefresh replaces them.
       * \param The application we want to refresh.
       */
     void refreshItemNamespace(QTreeWidgetItem *item, bool updateBoxes = true);
+
+    /*!
+      * \brief Replaces the items of a device once its namespace is rebuilt and restores the expanded items.
+      */
+    void finishItemNamespaceRefresh(QString deviceName, bool updateBoxes);
+
+    /*!
+      * \brief Forgets the refresh of a device whose namespace rebuild failed or was cancelled (a request which timed out) : its items are kept.
+      */
+    void abortItemNamespaceRefresh(QString deviceName);
     void refreshCurrentItemNamespace();
+    void refreshAllNamespaces();
+
+    /*!
+      * \brief Rebuilds the namespace of all the Minuit devices in background after a project is loaded
+      * with their namespace cache : the items are only updated if a device changed since the cache was stored.
+      */
+    void revalidateNamespaces();
     void deleteCurrentItemNamespace();
     void clickInNetworkTree(QTreeWidgetItem *item, int column);
     void valueChanged(QTreeWidgetItem* item, int column);
@@ -3,30 +3,114 @@
 
 #include <QObject>
 #include <QThread>
-class DeviceEdit;
+#include <QThreadPool>
+#include <QMetaType>
+#include <mutex>
+#include <set>
+#include <map>
+#include <string>
+
+/*!
+ * \class NetworkUpdate
+ *
+ * \brief The device configuration edited in a DeviceEdit, copied from the dialog so it can be applied by the NetworkUpdater thread.
+ */
+class NetworkUpdate
+{
+	public:
+		bool newDevice = false;
+		bool changed = false;
+		bool nameChanged = false;
+		bool localHostChanged = false;
+		bool networkPortChanged = false;
+		bool protocolChanged = false;
+		bool namespacePathChanged = false;
+
+		QString previousName;                   //!< The name of the device before the edition.
+		std::string name;
+		std::string protocol;
+		std::string localHost;
+		unsigned int destinationPort = 0;
+		unsigned int receptionPort = 0;
+		std::string namespaceFilePath;
+};
+
+Q_DECLARE_METATYPE(NetworkUpdate)
+
+/*!
+ * \class NetworkUpdater
+ *
+ * \brief Runs the Engine calls which can wait for a device (device configuration, namespace rebuild and loading)
+ * on a worker thread so the GUI stays responsive.
+ *
+ * The namespaces of several devices are rebuilt concurrently on a bounded thread pool (the Engine locks each device
+ * on its own) and namespaceRebuilt is emitted as soon as each device is done. The device configurations run one after
+ * the other on the updater thread. started is emitted when a request begins, so a time budget only counts the time
+ * spent on its own device.
+ *
+ * Each request has an id : a request can be cancelled (for example after a timeout) and its results are then dropped.
+ * Note : an Engine call which is already running can't be interrupted, cancellation is checked between the calls.
+ * A running request which is cancelled is finished at once (the tree is enabled again) while its Engine call goes on.
+ * finished is always emitted once, even for a request cancelled before it started, and a namespace rebuild always ends
+ * with namespaceRebuilt or namespaceRebuildFailed when its Engine call returned.
+ * The Engine locks the namespace of a device while it is rebuilt and the GUI requests about this device fail meanwhile,
+ * so the GUI thread never waits for a device.
+ */
 class NetworkUpdater : public QObject
 {
 		Q_OBJECT
 	public:
-		explicit NetworkUpdater(DeviceEdit* parent = 0);
+		explicit NetworkUpdater();
 		~NetworkUpdater();
 
+		/*!
+		 * \brief Cancels a request (thread safe).
+		 */
+		void cancel(unsigned int requestId);
+
+		static const int MAX_DISCOVERIES = 8;  //!< The maximum number of namespaces rebuilt at the same time.
+
 	signals:
 		void deviceChanged(QString);
 		void deviceNameChanged(QString,QString);
 		void deviceProtocolChanged(QString);
 		void newDeviceAdded(QString);
 		void namespaceLoaded(QString);
-		
+		void namespaceLoadFailed(QString message);
+		void namespaceRebuilt(QString deviceName, bool updateBoxes);
+		void namespaceRebuildFailed(QString deviceName);
+
+		void progress(QString step);
+		void started(unsigned int requestId);
+		void finished(unsigned int requestId);
+
 		void disableTree();
 		void enableTree();
-		
+
 	public slots:
-		void update();
+		void update(NetworkUpdate request, unsigned int requestId);
+		void rebuildNamespace(QString deviceName, bool updateBoxes, bool background, unsigned int requestId);
 
 	private:
+		friend class NamespaceDiscovery;
+
+		bool isCancelled(unsigned int requestId);
+		void discover(QString deviceName, bool updateBoxes, bool background, unsigned int requestId);
+
+		/** disable the tree while at least one request which isn't in background is running */
+		void beginRequest(unsigned int requestId, bool disable = true);
+		void endRequest(unsigned int requestId);
+		/** finish a running request (the mutex is locked) */
+		void release(unsigned int requestId);
+		/** forget a request cancelled before it started */
+		void dropRequest(unsigned int requestId);
+
 		QThread thrd;
-		DeviceEdit* ed;
+		QThreadPool pool;
+		std::mutex mutex;
+		std::set<unsigned int> cancelledRequests;
+		std::map<unsigned int, bool> runningRequests;   //!< The running requests and whether they disabled the tree.
+		unsigned int disablingRequests = 0;
 };
 
 #endif // NETWORKUPDATER_H
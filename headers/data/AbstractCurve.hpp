@@ -74,7 +74,7 @@ class AbstractCurve : public Abstract
 {
   public:
     AbstractCurve(unsigned int boxID, const std::string &address, unsigned int argPosition, unsigned int sampleRate,
-                  bool redundancy, bool show, bool interpolate, float lastPointCoeff, const std::vector<float> &curve,
+                  bool redundancy, bool show, bool interpolate, float lastPointCoeff, const CurveSamples &curve,
                   const std::map<float, std::pair<float, float> > &breakpoints);
 
     AbstractCurve(const AbstractCurve &other);
@@ -94,7 +94,7 @@ class AbstractCurve : public Abstract
     bool _redundancy;         //!< Handles curve's redundancy
     bool _show;
     bool _interpolate;
-    std::vector<float> _curve; //!< List of all curve values.
+    CurveSamples _curve;      //!< List of all curve values (shared with the Engines cache, never NULL).
     //! Map of breakpoints with their values and curving values.
     std::map<float, std::pair<float, float> > _breakpoints;
 
@@ -0,0 +1,125 @@
+/*
+ * Process-wide table of interned network addresses
+ * Copyright © 2026, agent
+ *
+ * License: This code is licensed under the terms of the "CeCILL-C"
+ * http://www.cecill.info
+ */
+
+#ifndef ADDRESS_TABLE_HPP
+#define ADDRESS_TABLE_HPP
+
+#include "TTModular.h"
+
+/*!
+ * \file AddressTable.hpp
+ * \author agent
+ * \date 2026
+ *
+ * \brief This file contains the table used by the Engine, the Maquette and the NetworkMessages to share network addresses.
+ *
+ */
+
+#include <string>
+#include <deque>
+#include <unordered_map>
+#include <mutex>
+
+/** a type dedicated to retreive an interned network address */
+typedef unsigned int AddressId;
+
+#define NO_ADDRESS_ID 0
+
+/*!
+ * \class AddressTable
+ *
+ * \brief A process-wide table mapping each network address to a compact id.
+ *
+ * Each address is parsed once : its network tree form (device/path) and its TTAddress form
+ * are cached so converting an address from one form to another is a lookup.
+ * Ids are given by TTAddress so different spellings of the same address share the same id
+ * and the network tree form of an id is always the normalized one.
+ * Ids are never released so they can be stored anywhere for the whole session.
+ * All the functions are thread safe.
+ */
+class AddressTable
+{
+
+private:
+
+    /** a class used to cache the different forms of an address */
+    class Entry {
+
+    public:
+        std::string     address;                                        /// network tree form (device/path)
+        TTAddress       ttAddress;                                      /// TTAddress form (device:/path as application directory and address)
+    };
+
+    std::deque<Entry>                           m_entries;              /// all the interned addresses (the first one is for NO_ADDRESS_ID)
+    std::unordered_map<std::string, AddressId>  m_ids;                  /// the id of each network tree address
+    std::unordered_map<std::string, AddressId>  m_ttIds;                /// the id of each TTAddress string
+    std::mutex                                  m_mutex;
+
+    AddressTable();
+
+    AddressId   append(const std::string& address, TTAddress& aTTAddress);
+
+public:
+
+    /*!
+     * Get the table shared by the whole application.
+     */
+    static AddressTable& getInstance();
+
+    /*!
+     * Get the id of a network tree address (device/path) interning it if needed.
+     *
+     * \param address : the network tree address.
+     * \return the id of the address (NO_ADDRESS_ID for an empty address).
+     */
+    AddressId   intern(const std::string& address);
+
+    /*!
+     * Get the id of a TTAddress interning it if needed.
+     *
+     * \param aTTAddress : the TTAddress.
+     * \return the id of the address (NO_ADDRESS_ID for an empty address).
+     */
+    AddressId   intern(TTAddress aTTAddress);
+
+    /*!
+     * Get the id of a network tree address without interning it.
+     *
+     * \param address : the network tree address.
+     * \return the id of the address or NO_ADDRESS_ID if the address is not interned.
+     */
+    AddressId   find(const std::string& address);
+
+    /*!
+     * Get the network tree form (device/path) of an address.
+     *
+     * \param id : the id of the address.
+     * \return the network tree address (empty for an unknown id).
+     */
+    const std::string&  address(AddressId id);
+
+    /*!
+     * Get the TTAddress form of an address.
+     *
+     * \param id : the id of the address.
+     * \return the TTAddress (kTTAdrsEmpty for an unknown id).
+     */
+    const TTAddress&    ttAddress(AddressId id);
+
+    /*!
+     * Convert a network tree address into a TTAddress without using the table.
+     */
+    static TTAddress    toTTAddress(const std::string& networktreeAddress);
+
+    /*!
+     * Convert a TTAddress into a network tree address without using the table.
+     */
+    static std::string  toNetworkTreeAddress(TTAddress aTTAddress);
+};
+
+#endif // ADDRESS_TABLE_HPP
@@ -0,0 +1,83 @@
+/*
+ * Native sampler for the power section curves
+ * Copyright © 2026, agent
+ *
+ * License: This code is licensed under the terms of the "CeCILL-C"
+ * http://www.cecill.info
+ */
+
+#ifndef CURVE_SAMPLER_HPP
+#define CURVE_SAMPLER_HPP
+
+/*!
+ * \file CurveSampler.hpp
+ * \author agent
+ * \date 2026
+ *
+ * \brief This file contains a sampler computing a whole curve in one pass without the Jamoma function objects.
+ *
+ */
+
+#include <vector>
+
+/** a class used to describe a point of a curve as it is stored into the functionParameters of a curve */
+class CurvePoint {
+
+public:
+    float   x;                                  /// the position of the point into the curve (between 0. and 1.)
+    float   y;                                  /// the value of the curve at this point
+    float   power;                              /// the power of the section ending at this point (1. means linear)
+
+    CurvePoint(float x = 0., float y = 0., float power = 1.) : x(x), y(y), power(power) {}
+};
+
+/** a type to pass all the points of a curve (sorted by x) */
+typedef std::vector<CurvePoint> CurvePoints;
+
+/*!
+ * \class CurveSampler
+ *
+ * \brief Samples the piecewise power curves edited by i-score.
+ *
+ * Between two points the value goes from y0 to y1 as y0 + (y1 - y0) * t^power where t is the normalized position
+ * into the section. Before the first point and after the last one the curve holds the value of the point.
+ *
+ * The sections are evaluated by blocks using AVX2 or SSE2 instructions when the compiler enables them
+ * (__AVX2__ or __SSE2__) and with std::pow otherwise.
+ */
+class CurveSampler
+{
+
+public:
+
+    /*!
+     * Samples a curve at nbSamples regularly spaced positions from 0. to 1. (both included).
+     *
+     * \param points : the points of the curve sorted by x.
+     * \param output : a buffer of nbSamples floats to fill.
+     * \param nbSamples : the number of samples to compute.
+     * \return false if the curve has no point.
+     */
+    static bool sample(const CurvePoints& points, float* output, unsigned int nbSamples);
+
+    /*!
+     * Samples a curve point by point with std::pow (the reference for the vectorized sampling).
+     */
+    static bool sampleScalar(const CurvePoints& points, float* output, unsigned int nbSamples);
+
+    /*!
+     * Gets the name of the instruction set used by sample ("avx2", "sse2" or "scalar").
+     */
+    static const char* instructionSet();
+
+private:
+
+    /** fill output[begin] to output[end - 1] with the section going from a to b */
+    static void sampleSection(const CurvePoint& a, const CurvePoint& b, float step, float* output, unsigned int begin, unsigned int end);
+    static void sampleSectionScalar(const CurvePoint& a, const CurvePoint& b, float step, float* output, unsigned int begin, unsigned int end);
+
+    /** the sampling loop shared by the vectorized and the scalar versions */
+    static bool sample(const CurvePoints& points, float* output, unsigned int nbSamples, bool vectorized);
+};
+
+#endif // CURVE_SAMPLER_HPP
@@ -11,6 +11,10 @@
 
 #include "TTScore.h"
 #include "TTModular.h"
+#include "AddressTable.hpp"
+#include "TripleBuffer.hpp"
+#include "RingBuffer.hpp"
+#include "CurveSampler.hpp"
 
 /*!
  * \file Engine.h
@@ -23,7 +27,14 @@
 
 #include <string>
 #include <map>
+#include <set>
 #include <vector>
+#include <memory>
+#include <algorithm>
+#include <mutex>
+#include <chrono>
+#include <atomic>
+#include <thread>
 
 #include <QColor>
 #include <QPointF>
@@ -61,6 +72,10 @@ public:
     TTAddress       address;
     TTObject        subScenario;
     TTObject        loop;
+    unsigned int    parent;                     /// the id of the parent time box (only for time boxes)
+    std::vector<unsigned int> children;         /// the ids of the time boxes inside the sub scenario (only for time boxes)
+    std::vector<unsigned int> relations;        /// the ids of the intervals linked to a time box or the ids of the two time boxes linked by an interval
+    unsigned int    curveEdits;                 /// incremented each time the curves of a time box may change (see getCurveValues)
     
     EngineCacheElement();
     ~EngineCacheElement();
@@ -68,15 +83,212 @@ public:
 };
 typedef EngineCacheElement* EngineCacheElementPtr;
 
-/** a type that contains an id and a cached element */
-typedef std::pair<unsigned int, EngineCacheElementPtr> EngineCacheKey;
-typedef	EngineCacheKey*	EngineCacheKeyPtr;
+#define NO_BOUND -1
+
+#define NO_ID 0
+#define ROOT_BOX_ID 1
+
+/** an id stored into an EngineSlotMap is made of a slot index (low bits) and a generation (high bits) */
+#define ENGINE_SLOT_INDEX_BITS 24
+#define ENGINE_SLOT_INDEX_MASK ((1u << ENGINE_SLOT_INDEX_BITS) - 1)
+#define ENGINE_SLOT_GENERATION_MASK 0xFFu
+
+/*!
+ * \class EngineSlotMap
+ *
+ * \brief A generational slot map used to store and retreive cached elements relative to an id.
+ *
+ * Elements are stored contiguously and looked up in constant time using the slot index of the id.
+ * When an element is erased or cleared its generation is incremented so the former id can't reach
+ * the element which will reuse the slot : find returns NULL instead.
+ * Only a map which allocates its ids with insert recycles the free slots, a map filled with insertAt
+ * uses the ids given by another map.
+ * The slot 0 is never used so NO_ID is always unknown.
+ */
+template <typename T>
+class EngineSlotMap {
+
+    struct Slot {
+        T               element;
+        unsigned int    generation;
+        bool            occupied;
+        
+        Slot() : generation(0), occupied(false) {}
+    };
+    
+    std::vector<Slot>           m_slots;
+    std::vector<unsigned int>   m_freeSlots;
+    unsigned int                m_size;
+    bool                        m_allocating;   // true once an id has been allocated by insert
+    
+    static unsigned int makeId(unsigned int index, unsigned int generation)
+    {
+        return index | ((generation & ENGINE_SLOT_GENERATION_MASK) << ENGINE_SLOT_INDEX_BITS);
+    }
+    
+public:
+    
+    /** an iterator over the occupied slots only */
+    class iterator {
+        
+        friend class EngineSlotMap;
+        
+        std::vector<Slot>*  m_slots;
+        unsigned int        m_index;
+        
+        iterator(std::vector<Slot>* slots, unsigned int index) : m_slots(slots), m_index(index) { skip(); }
+        
+        void skip() { while (m_index < m_slots->size() && !(*m_slots)[m_index].occupied) m_index++; }
+        
+    public:
+        
+        /** the id of the current element */
+        unsigned int id() const { return makeId(m_index, (*m_slots)[m_index].generation); }
+        
+        T& operator*() const { return (*m_slots)[m_index].element; }
+        T* operator->() const { return &(*m_slots)[m_index].element; }
+        
+        iterator& operator++() { m_index++; skip(); return *this; }
+        bool operator==(const iterator& other) const { return m_index == other.m_index; }
+        bool operator!=(const iterator& other) const { return m_index != other.m_index; }
+    };
+    
+    EngineSlotMap() : m_slots(1), m_size(0), m_allocating(false) {}
+    
+    iterator begin() { return iterator(&m_slots, 1); }
+    iterator end() { return iterator(&m_slots, m_slots.size()); }
+    
+    unsigned int size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    
+    /** the id the next insert call will return */
+    unsigned int nextId() const
+    {
+        if (!m_freeSlots.empty())
+            return makeId(m_freeSlots.back(), m_slots[m_freeSlots.back()].generation);
+        
+        return m_slots.size();
+    }
+    
+    /** the slot index of the id the next insert call will return */
+    unsigned int nextIndex() const { return nextId() & ENGINE_SLOT_INDEX_MASK; }
+    
+    /** store an element into a free slot and return its id */
+    unsigned int insert(const T& element)
+    {
+        unsigned int index;
+        
+        m_allocating = true;
+        
+        if (!m_freeSlots.empty()) {
+            index = m_freeSlots.back();
+            m_freeSlots.pop_back();
+        }
+        else {
+            index = m_slots.size();
+            m_slots.push_back(Slot());
+        }
+        
+        m_slots[index].element = element;
+        m_slots[index].occupied = true;
+        m_size++;
+        
+        return makeId(index, m_slots[index].generation);
+    }
+    
+    /** store an element using an id given by another slot map (to cache several elements relative to the same id) */
+    void insertAt(unsigned int id, const T& element)
+    {
+        unsigned int index = id & ENGINE_SLOT_INDEX_MASK;
+        
+        if (index == NO_ID)
+            return;
+        
+        if (index >= m_slots.size())
+            m_slots.resize(index + 1);
+        
+        if (!m_slots[index].occupied) {
+            
+            m_size++;
+            
+            // the slot is taken back from the free list of an allocating map
+            if (m_allocating)
+                m_freeSlots.erase(std::remove(m_freeSlots.begin(), m_freeSlots.end(), index), m_freeSlots.end());
+        }
+        
+        m_slots[index].element = element;
+        m_slots[index].generation = id >> ENGINE_SLOT_INDEX_BITS;
+        m_slots[index].occupied = true;
+    }
+    
+    /** return the element relative to an id or NULL if the id is unknown or stale */
+    T* find(unsigned int id)
+    {
+        unsigned int index = id & ENGINE_SLOT_INDEX_MASK;
+        
+        if (index == NO_ID || index >= m_slots.size())
+            return NULL;
+        
+        Slot& slot = m_slots[index];
+        
+        if (!slot.occupied || slot.generation != (id >> ENGINE_SLOT_INDEX_BITS))
+            return NULL;
+        
+        return &slot.element;
+    }
+    
+    bool contains(unsigned int id) { return find(id) != NULL; }
+    
+    /** release the element relative to an id and recycle its slot : return false if the id is unknown or stale */
+    bool erase(unsigned int id)
+    {
+        if (!find(id))
+            return false;
+        
+        unsigned int index = id & ENGINE_SLOT_INDEX_MASK;
+        Slot& slot = m_slots[index];
+        
+        slot.element = T();
+        slot.occupied = false;
+        slot.generation = (slot.generation + 1) & ENGINE_SLOT_GENERATION_MASK;
+        m_size--;
+        
+        if (m_allocating)
+            m_freeSlots.push_back(index);
+        
+        return true;
+    }
+    
+    /** release all the elements : the generations are kept so the former ids stay stale */
+    void clear()
+    {
+        m_freeSlots.clear();
+        
+        // the lowest slots are reused first
+        for (unsigned int index = m_slots.size() - 1; index > 0; index--) {
+            
+            Slot& slot = m_slots[index];
+            
+            if (slot.occupied) {
+                
+                slot.element = T();
+                slot.occupied = false;
+                slot.generation = (slot.generation + 1) & ENGINE_SLOT_GENERATION_MASK;
+            }
+            
+            if (m_allocating)
+                m_freeSlots.push_back(index);
+        }
+        
+        m_size = 0;
+    }
+};
 
 /** a type to define a map to store and retreive a cached element relative to an id */
-typedef std::map<unsigned int, EngineCacheElementPtr> EngineCacheMap;
+typedef EngineSlotMap<EngineCacheElement> EngineCacheMap;
 typedef	EngineCacheMap*	EngineCacheMapPtr;
 
-typedef std::map<unsigned int, EngineCacheElementPtr>::iterator EngineCacheMapIterator;
+typedef EngineCacheMap::iterator EngineCacheMapIterator;
 
 /** a type to define a map to store and retreive the triggerIds associated with a conditionId */
 typedef std::map<unsigned int, std::list<unsigned int>> EngineConditionsMap;
@@ -84,10 +296,154 @@ typedef std::map<unsigned int, std::list<unsigned int>> EngineConditionsMap;
 /** a map used to remember the namespace file path for each device */
 typedef std::map<std::string, std::string> EngineFilesMap;
 
-#define NO_BOUND -1
+/** a map used to remember the hash of the namespace cache loaded for each device */
+typedef std::map<std::string, TTUInt64> EngineHashesMap;
 
-#define NO_ID 0
-#define ROOT_BOX_ID 1
+/** a class used to pass a line of the state of a control point without formatting it into a string */
+class StateLine {
+    
+public:
+    AddressId       address;
+    TTValue         value;
+    
+    StateLine(AddressId anAddress = NO_ADDRESS_ID, const TTValue& aValue = TTValue()) : address(anAddress), value(aValue) {}
+};
+
+/** a type to pass the whole state of a control point */
+typedef std::vector<StateLine> StateLines;
+
+/** a class used to describe a node of a device namespace with its cached attributes (formatted as strings, empty when the object doesn't have it) */
+class NamespaceNode {
+    
+public:
+    std::string     address;                    /// the network tree address of the node (e.g. deviceName/a/b)
+    std::string     type;                       /// the type of the object registered at this address ("none" if there is no object)
+    std::string     service;
+    std::string     priority;
+    std::string     tags;
+    std::string     range;                      /// the rangeBounds attribute
+    std::string     clipmode;                   /// the rangeClipmode attribute
+};
+
+/** a type to pass a whole branch of a namespace (each node comes before its children) */
+typedef std::vector<NamespaceNode> NamespaceNodes;
+
+/** a class used to report a time box moved by an edition with its new dates */
+class MovedTimeBox {
+    
+public:
+    TimeBoxId       id;
+    TimeValue       start;
+    TimeValue       end;
+    
+    MovedTimeBox(TimeBoxId anId, TimeValue aStart, TimeValue anEnd) : id(anId), start(aStart), end(anEnd) {}
+};
+
+/** a type to return the time boxes moved by an edition */
+typedef std::vector<MovedTimeBox> MovedTimeBoxes;
+
+/** a type to share the sampled values of a curve without copying them */
+typedef std::shared_ptr<const std::vector<float> > CurveSamples;
+
+/** a class used to cache the sampled values of a curve */
+class CurveSamplesCacheElement {
+
+public:
+    unsigned int    edit;                       /// the curveEdits of the time box when the curve was sampled
+    CurveSamples    samples;
+    
+    CurveSamplesCacheElement() : edit(0) {}
+};
+
+/** a type to cache the sampled curves of each time box */
+typedef std::map<std::pair<TimeBoxId, AddressId>, CurveSamplesCacheElement> CurveSamplesCacheMap;
+
+/** the number of curves the CurveSampler has to sample as the Jamoma curves do before to replace them (see getCurveValues) */
+#define CURVE_SAMPLER_CHECKS 16
+
+/** the largest difference accepted between the CurveSampler and the Jamoma curves (relative to the range of the curve) */
+#define CURVE_SAMPLER_TOLERANCE 1e-3
+
+/** a class used to cache an attribute of the object registered at an address (see requestObjectAttributeValue) */
+class AttributeCacheElement {
+    
+public:
+    enum Status {NoDirectory, NoObject, NoAttribute, Found, Busy};     /// Busy : the namespace of the device is being rebuilt (never cached)
+    
+    Status          status;
+    TTValue         value;                      /// the value of the attribute (the name of the object for the type)
+    std::string     text;                       /// the value formatted as a string
+    bool            remote;                     /// true for a mirror : the device can change the value without notification
+    std::chrono::steady_clock::time_point date; /// when the value was read
+    
+    AttributeCacheElement() : status(NoDirectory), remote(false) {}
+};
+
+/** a type to cache the attributes of each address (an empty attribute name stands for the type of the object) */
+typedef std::map<std::pair<AddressId, std::string>, AttributeCacheElement> AttributeCacheMap;
+
+/** the default time to live of the cached attributes of the remote devices (in ms) */
+#define ATTRIBUTE_CACHE_TTL 2000
+
+/** a class used to pass the execution state to the GUI once per frame (see getExecutionState) */
+class ExecutionState {
+    
+public:
+    bool            running;                    /// true if the main scenario is running (even if it is paused)
+    bool            paused;                     /// true if the main scenario is paused
+    TimeValue       date;                       /// the current execution date of the main scenario
+    std::map<TimeBoxId, float> positions;       /// the execution position (normalized [0::1]) of each running time box
+    std::map<ConditionedTimeBoxId, bool> triggers;  /// the active state of each trigger point which changed during the execution
+    
+    ExecutionState() : running(false), paused(false), date(0) {}
+};
+
+/** the period used to sample the execution state during the execution (in ms) */
+#define EXECUTION_STATE_PERIOD 10
+
+/** a class used to pass a scheduler notification to the GUI thread (see processExecutionEvents) */
+class ExecutionEvent {
+    
+public:
+    enum Type {
+        BoxRunning,                             /// a time box starts or ends : value is the running state
+        TriggerStatus,                          /// the status of a trigger point event changed : the active state is read when the event is processed
+        TriggerReady,                           /// the condition of a trigger point becomes ready or not : value is the ready state
+        TriggerActive                           /// the active state of a trigger point processed by the GUI thread (see setExecutionTriggerActive) : value is the active state
+    };
+    
+    Type            type;
+    unsigned int    id;                         /// a TimeBoxId or a ConditionedTimeBoxId
+    bool            value;
+};
+
+/** the number of scheduler notifications which can wait for the GUI thread (a power of two) */
+#define EXECUTION_EVENTS_CAPACITY 4096
+
+/** the formats of the trace written by a score export */
+enum TraceFormat {
+    TraceCSV,                                   /// a "date,device,address,value" text line by message
+    TraceBinary                                 /// a compact binary record by message (see exportScore)
+};
+
+/** a class used to get all the informations needed to display a time box in one call */
+class BoxDescriptor {
+    
+public:
+    TimeBoxId       id;
+    TimeBoxId       parentId;
+    std::string     name;
+    TimeValue       beginTime;
+    TimeValue       endTime;
+    TimeValue       duration;
+    unsigned int    verticalPosition;
+    unsigned int    verticalSize;
+    QColor          color;
+    bool            muteState;
+    bool            loopState;
+    
+    BoxDescriptor() : id(0), parentId(0), beginTime(0), endTime(0), duration(0), verticalPosition(0), verticalSize(0), muteState(false), loopState(false) {}
+};
 
 #define NO_MAX_MODIFICATION 0
 
@@ -116,13 +472,10 @@ private:
     
     TTSymbol            m_lastProjectFilePath;                          /// the last project file path
     EngineFilesMap      m_namespaceFilesPath;                           /// the last namespace file used for each device
+    EngineHashesMap     m_namespaceCacheHashes;                         /// the hash of the namespace cache loaded for each device
     
     TTObject            m_mainScenario;                                 /// The top scenario
     
-    unsigned int        m_nextTimeBoxId;                                /// the next Id to give to any created time process
-    unsigned int        m_nextIntervalId;                               /// the next Id to give to any created interval
-    unsigned int        m_nextConditionedTimeBoxId;                     /// the next Id to give to any created time process
-    
     EngineCacheMap      m_timeBoxMap;                                   /// All time boxes (e.g. automation + sub scenario + loop and some observers) stored using an unique id
     EngineCacheMap      m_intervalMap;                                  /// All interval processes and some observers stored using an unique id
     EngineCacheMap      m_timeConditionMap;                             /// All condition stored using an unique id
@@ -140,12 +493,57 @@ private:
     TTObject            m_iscore;                                       /// #TTApplication dedicated to i-score
     TTObject            m_sender;                                       /// #TTSender to send message to any application
     TTObject            m_namespaceObserver;                            /// #TTCallback to be notified when a node is created in learn mode
+    std::vector<TTObject> m_transportData;                              /// #TTData registered under /Transport to control the execution remotely
+    
+    bool                m_editing;                                      /// true between beginEdit and commitEdit
+    std::map<TimeBoxId, std::pair<TimeValue, TimeValue>> m_pendingMoves;/// the moves queued by performBoxEditing during an edit
+    
+    CurveSamplesCacheMap m_curveSamplesCache;                           /// the last sampled values of each curve
+    std::set<std::pair<TimeBoxId, AddressId> > m_recordingCurves;       /// the curves changed by their automation while recording (never cached)
+    int                 m_curveSamplerChecks;                           /// the number of curves the CurveSampler sampled as the Jamoma curves (-1 if it didn't once : the Jamoma curves are kept)
+    bool                m_curveSamplerPowerChecked;                     /// true if one of the checked curves had a section which isn't linear
+    
+    std::recursive_mutex m_devicesMutex;                                /// serializes the changes of the devices list and of their protocols (only held for short calls : never while a device answers)
+    std::map<std::string, std::unique_ptr<std::recursive_mutex> > m_directoryMutexes;  /// the lock of the namespace of each device : a rebuild holds it until the device answered (the readers don't wait for it)
+    
+    AttributeCacheMap   m_attributeCache;                               /// the last static attributes read by requestObjectAttributeValue, requestObjectType and requestObjectPriority (never the value)
+    std::mutex          m_attributeCacheMutex;                          /// the namespace can be rebuilt by another thread (see NetworkUpdater)
+    std::chrono::milliseconds m_attributeCacheTTL;                      /// the time to live of the cached attributes of the remote devices (0 means no expiration)
+    unsigned int        m_attributeCacheEpoch;                          /// incremented by each invalidation so a lookup started before it doesn't cache a stale attribute
+    
+    ExecutionState      m_executionState;                               /// the execution state built by the samplers from m_executionStateEvents
+    std::mutex          m_executionStateMutex;                          /// serializes the samplers : the sampling thread, play, stop and pause (the scheduler callbacks and the reader never lock it)
+    RingBuffer<ExecutionEvent, EXECUTION_EVENTS_CAPACITY> m_executionStateEvents;   /// the box running and trigger active changes waiting for the next sample
+    std::atomic<bool>   m_executionStateOverflow;                       /// true if a change was lost because m_executionStateEvents was full
+    TripleBuffer<ExecutionState> m_executionStateBuffer;                /// the last published execution state, read by the GUI without locking
+    std::thread         m_executionStateSampler;                        /// samples the date and the positions while the execution goes on
+    std::atomic<bool>   m_executionStateSampling;                       /// false to ask the sampling thread to exit
+    
+    RingBuffer<ExecutionEvent, EXECUTION_EVENTS_CAPACITY> m_executionEvents;    /// the scheduler notifications waiting for processExecutionEvents
+    std::atomic<bool>   m_executionEventsOverflow;                      /// true if a notification was lost because the queue was full
     
-	void (*m_TimeEventStatusAttributeCallback)(ConditionedTimeBoxId, bool);         // allow to notify the Maquette if a triggerpoint is pending
-    void (*m_TimeProcessSchedulerRunningAttributeCallback)(TimeBoxId, bool);        // allow to notify the Maquette if a box is running or not
+	void (*m_TimeEventStatusAttributeCallback)(ConditionedTimeBoxId, bool);         // allow to notify the Maquette if a triggerpoint is pending (called by processExecutionEvents)
+    void (*m_TimeProcessSchedulerRunningAttributeCallback)(TimeBoxId, bool);        // allow to notify the Maquette if a box is running or not (called by processExecutionEvents)
     void (*m_TransportDataValueCallback)(TTSymbol&, const TTValue&);                // allow to notify the Maquette if the transport features have been used remotly (via OSC messages for example)
     void (*m_NetworkDeviceNamespaceCallback)(TTSymbol&);                            // allow to notify the Maquette if a device's namespace have changed (see in setDeviceLearn)
     void (*m_NetworkDeviceConnectionError)(TTSymbol&, TTSymbol&);                   // allow to notify the Maquette if a device connection failed
+    
+    EngineCacheElement& getTimeBoxElement(TimeBoxId boxId, const char* method);     // log and return an empty element if the id is unknown or stale
+    bool checkCurveSampler(const CurvePoints& points, const std::vector<float>& samples, const TTValue& curveValues);  // compare the CurveSampler with the Jamoma curves (false and rejected on the first mismatch)
+    AttributeCacheElement getObjectAttribute(AddressId address, const std::string& attribute);  // read an attribute from the cache or from the directory
+    void invalidateAttributeCache(AddressId address = NO_ADDRESS_ID);                  // forget the attributes of an address (or of all addresses) after a namespace change
+    
+    std::recursive_mutex& directoryMutex(const std::string& deviceName);               // the lock of the namespace of a device (never released : a request can still hold it after the device is removed)
+    TTNodeDirectoryPtr tryLockDirectory(TTAddress anAddress, std::unique_lock<std::recursive_mutex>& directoryLock);   // the directory of an address or NULL (directoryLock doesn't own the lock if the namespace is being rebuilt)
+    
+    bool sampleExecutionState();                                                        // apply the queued changes, read the date and the positions from the scheduler then publish them (return false when nothing runs anymore)
+    void publishExecutionState();                                                       // copy the execution state into the triple buffer (m_executionStateMutex has to be locked)
+    void setExecutionBoxRunning(TimeBoxId boxId, bool running);                         // queue the running state of a time box for the next sample (never locks)
+    void setExecutionTriggerActive(ConditionedTimeBoxId triggerId, bool active);        // queue the active state of a trigger point for the next sample (never locks)
+    void startExecutionStateSampling();                                                 // (re)start the sampling thread
+    void stopExecutionStateSampling();                                                  // stop the sampling thread and wait for it
+    void pushExecutionEvent(ExecutionEvent::Type type, unsigned int id, bool value = false);   // queue a scheduler notification without waiting for the GUI thread
+    bool isTriggerActive(ConditionedTimeBoxId triggerId);                               // true if the event of a trigger point is pending and its condition is ready
 
 public:
 
@@ -169,6 +567,7 @@ public:
     void initScore(const char* pathToTheJamomaFolder = NULL);
     
     void registerIscoreToProtocols();
+    void registerIscoreTransportData();
     
     void dumpAddressBelow(TTNodePtr aNode);
     
@@ -177,7 +576,8 @@ public:
 	{ return m_workingProtocols; }
     // Id management //////////////////////////////////////////////////////////////////
     
-    TimeBoxId           cacheTimeBox(TTObject& automation, TTAddress& anAddress, TTObject& subScenario);
+    TimeBoxId           cacheTimeBox(TTObject& automation, TTAddress& anAddress, TTObject& subScenario, TimeBoxId parentId = NO_ID);
+    bool                isTimeBoxCached(TimeBoxId boxId);
     TTObject&           getMainProcess(TimeBoxId boxId);
     TTObject&           getAutomation(TimeBoxId boxId);
     TTObject&           getSubScenario(TimeBoxId boxId);
@@ -188,9 +588,21 @@ public:
     void                clearTimeBox();
     
     TimeBoxId           getParentId(TimeBoxId boxId);
+    TimeValue           getBoxAbsoluteBeginTime(TimeBoxId boxId);
+    bool                isBoxMutedInScore(TimeBoxId boxId);
     void                getChildrenId(TimeBoxId boxId, std::vector<TimeBoxId>& childrenId);
     
-    IntervalId          cacheInterval(TTObject& interval);
+    void                snapshotRelatedDates(const std::vector<TimeBoxId>& boxesId, MovedTimeBoxes& dates);
+    void                getMovedBoxes(const MovedTimeBoxes& datesBefore, MovedTimeBoxes& movedBoxes);
+    
+    void                invalidateCurveSamples(TimeBoxId boxId);
+    void                invalidateCurveSamples(TimeBoxId boxId, AddressId addressId);
+    void                eraseCurveSamples(TimeBoxId boxId);
+    
+    void                getBoxDescriptor(TimeBoxId boxId, EngineCacheElement& e, BoxDescriptor& descriptor);
+    
+    IntervalId          cacheInterval(TTObject& interval, TimeBoxId parentId = NO_ID);
+    void                linkInterval(IntervalId relationId, TimeBoxId boxId1, TimeBoxId boxId2);
     TTObject&           getInterval(IntervalId relationId);
     void                uncacheInterval(IntervalId relationId);
     void                clearInterval();
@@ -199,6 +611,7 @@ public:
     TTObject&           getConditionedTimeProcess(ConditionedTimeBoxId triggerId, TimeEventIndex& controlPointId);
     void                uncacheConditionedTimeBox(ConditionedTimeBoxId triggerId);
     void                clearConditionedTimeBox();
+    TimeConditionId     reserveConditionId();
     
     void                cacheTimeCondition(ConditionedTimeBoxId triggerId, TTObject& timeCondition, TTAddress& anAddress = kTTAdrsEmpty);
     TTObject&           getTimeCondition(ConditionedTimeBoxId triggerId);
@@ -226,11 +639,20 @@ public:
     
     /*!
 	 * Get the next time box ID to prepare a name.
+	 * Ids of removed boxes are recycled with a new generation (see EngineSlotMap).
 	 *
 	 * \return the next time box ID.
 	 */
 	TimeBoxId getNextTimeBoxId();
     
+    /*!
+	 * Get the number of the next time box to prepare a name (the first box is 1).
+	 * Unlike its id it doesn't depend on the generation of a recycled slot.
+	 *
+	 * \return the number of the next time box.
+	 */
+	unsigned int getNextTimeBoxNumber();
+    
 	/*!
 	 * Adds a new box in the CSP.
 	 *
@@ -258,13 +680,13 @@ public:
 	 * \param controlPoint1 : the index of the point in the first box to put in relation
 	 * \param boxId2 : the ID of the second box
 	 * \param controlPoint2 : the index of the point in the second box to put in relation
-	 * \param movedBoxes : empty vector, will be filled with the ID of the boxes moved by this new relation
+	 * \param movedBoxes : empty vector, will be filled with the ID and the new dates of the boxes moved by this new relation
 	 *
 	 * \return the newly created relation id (NO_ID if the creation is impossible).
 	 */
 	IntervalId addTemporalRelation(TimeBoxId boxId1, TimeEventIndex controlPoint1,
                                      TimeBoxId boxId2, TimeEventIndex controlPoint2,
-                                     std::vector<TimeBoxId>& movedBoxes);
+                                     MovedTimeBoxes& movedBoxes);
     
     /*!
 	 * Removes the temporal relation using given id.
@@ -279,9 +701,9 @@ public:
 	 * \param relationId : the relation to change the bounds.
 	 * \param minBound : the min bound for the box relation in ms.
 	 * \param maxBound : the max bound for the box relation in ms. NO_BOUND if the max bound is not used (+infinity).
-	 * \param movedBoxes : empty vector, will be filled with the ID of the boxes moved by this new relation.
+	 * \param movedBoxes : empty vector, will be filled with the ID and the new dates of the boxes moved by this new bounds.
 	 */
-	void changeTemporalRelationBounds(IntervalId relationId, BoundValue minBound, BoundValue maxBound, std::vector<TimeBoxId>& movedBoxes);
+	void changeTemporalRelationBounds(IntervalId relationId, BoundValue minBound, BoundValue maxBound, MovedTimeBoxes& movedBoxes);
     
 	/*!
 	 * Checks if a relation exists between the two given control points.
@@ -343,11 +765,28 @@ public:
 	 * \param x : new begin value of the box
 	 * \param y : new end value of the box
 	 * \param maxSceneWidth : the max scene width
-	 * \param movedBoxes : empty vector, will be filled with the ID of the boxes moved by this resolution
+	 * \param movedBoxes : empty vector, will be filled with the ID and the new dates of the boxes moved by this resolution (including the edited box)
 	 *
 	 * \return true if the move is allowed or false if the move is forbidden
 	 */
-	bool performBoxEditing(TimeBoxId boxId, TimeValue start, TimeValue end, std::vector<TimeBoxId>& movedBoxes);
+	bool performBoxEditing(TimeBoxId boxId, TimeValue start, TimeValue end, MovedTimeBoxes& movedBoxes);
+    
+    /*!
+	 * Begins an edition of several boxes : until commitEdit, performBoxEditing only queues the moves
+	 * (the last move of a box replaces the former ones) and returns true without filling movedBoxes.
+	 */
+	void beginEdit();
+    
+    /*!
+	 * Applies all the moves queued since beginEdit and returns the boxes moved by all of them at once.
+	 * A queued move is skipped if the box has already been moved at the wanted dates by a former move.
+	 *
+	 * \param movedBoxes : empty vector, will be filled with the ID and the new dates of the boxes moved by the edition
+	 * \param refusedBoxes : empty vector, will be filled with the ID of the boxes whose move is forbidden
+	 *
+	 * \return true if all the moves are allowed
+	 */
+	bool commitEdit(MovedTimeBoxes& movedBoxes, std::vector<TimeBoxId>& refusedBoxes);
     
     /*!
 	 * Gets the name of the box matching the given ID
@@ -538,6 +977,24 @@ public:
 	 */
 	void getCtrlPointMessagesToSend(TimeBoxId boxId, TimeEventIndex controlPointIndex, std::vector<std::string>& messages);
     
+    /*!
+	 * Sets the state to send when the given controlPoint is reached without parsing any string.
+	 *
+	 * \param boxId : the ID of the box containing this controlPoint.
+	 * \param controlPointIndex : the index of the point to set the state.
+	 * \param state : the address and the value of each line of the state.
+	 */
+	void setCtrlPointState(TimeBoxId boxId, TimeEventIndex controlPointIndex, const StateLines& state);
+    
+    /*!
+	 * Gets the state to send when the given controlPoint is reached without formatting any string.
+	 *
+	 * \param boxId : the ID of the box containing this controlPoint.
+	 * \param controlPointIndex : the index of the control point.
+	 * \param state : vector to fill with the address and the value of each line of the state (the result)
+	 */
+	void getCtrlPointState(TimeBoxId boxId, TimeEventIndex controlPointIndex, StateLines& state);
+    
 	/*!
 	 * Sets the control point mute state. If muted, the messages related to this control point will not be send.
 	 *
@@ -712,6 +1169,76 @@ public:
 	 */
 	bool getCurveValues(TimeBoxId boxId, const std::string & address, unsigned int argNb, std::vector<float>& result);
     
+    /*!
+	 * Curve functions working on an address interned into the AddressTable.
+	 * They avoid to parse the curve address at each call and are prefered for repeated access.
+	 */
+	void addCurve(TimeBoxId boxId, AddressId addressId);
+	void removeCurve(TimeBoxId boxId, AddressId addressId);
+	void getCurvesAddress(TimeBoxId boxId, std::vector<AddressId>& curveAddresses);
+	void setCurveSampleRate(TimeBoxId boxId, AddressId addressId, unsigned int nbSamplesBySec);
+	unsigned int getCurveSampleRate(TimeBoxId boxId, AddressId addressId);
+	void setCurveRedundancy(TimeBoxId boxId, AddressId addressId, bool redundancy);
+	bool getCurveRedundancy(TimeBoxId boxId, AddressId addressId);
+	void setCurveMuteState(TimeBoxId boxId, AddressId addressId, bool muteState);
+	bool getCurveMuteState(TimeBoxId boxId, AddressId addressId);
+	void setCurveRecording(TimeBoxId boxId, AddressId addressId, bool record);
+	bool setCurveSections(TimeBoxId boxId, AddressId addressId, unsigned int argNb,
+                          const std::vector<float>& xPercents, const std::vector<float>& yValues, const std::vector<short>& sectionType, const std::vector<float>& coeff);
+	bool getCurveSections(TimeBoxId boxId, AddressId addressId, unsigned int argNb,
+                          std::vector<float> & percent,  std::vector<float> & y,  std::vector<short> & sectionType,  std::vector<float> & coeff);
+	bool getCurveValues(TimeBoxId boxId, AddressId addressId, unsigned int argNb, std::vector<float>& result);
+    
+    /*!
+	 * Gets the curve values at it will be sent, at the previously set sampleRate, without copying them.
+	 *
+	 * The values are sampled once and kept until the curve parameters, the sample rate or the box duration change.
+	 *
+	 * \param boxId : the Id of the box.
+	 * \param addressId : curve address.
+	 * \param argNb : the arg index to get the curve value result.
+	 * \param result : the shared sampled values.
+	 *
+	 * \return false if the curve could not be compute, or if the argument is a string.
+	 */
+	bool getCurveValues(TimeBoxId boxId, AddressId addressId, unsigned int argNb, CurveSamples& result);
+    
+    /*!
+	 * Samples a curve at any resolution without the scheduler (for the score export).
+	 *
+	 * \param boxId : the Id of the box.
+	 * \param addressId : curve address.
+	 * \param nbSamples : the number of values to compute from the start to the end of the box (both included).
+	 * \param result : the sampled values.
+	 *
+	 * \return false if the curve doesn't exist, if it is not made of power sections or if the CurveSampler didn't sample as the Jamoma curves.
+	 */
+	bool sampleCurve(TimeBoxId boxId, AddressId addressId, unsigned int nbSamples, std::vector<float>& result);
+    
+    /*!
+	 * Tells if the curves are sampled by the CurveSampler.
+	 *
+	 * The Jamoma curves sample the curves until the CurveSampler gave the same values for CURVE_SAMPLER_CHECKS curves
+	 * (at least one with a section which isn't linear) : same number of values, same end points and no difference
+	 * larger than CURVE_SAMPLER_TOLERANCE. After a single mismatch the Jamoma curves are kept.
+	 *
+	 * \return true once the CurveSampler has been checked.
+	 */
+	bool isCurveSamplerChecked();
+    
+    /*!
+	 * Samples curve sections as setCurveSections would store them, without changing the curve (to preview an edition).
+	 *
+	 * \param percent : x-axis values in percents.
+	 * \param y : y-axis values.
+	 * \param coeff : the coeff of each section (see setCurveSections).
+	 * \param nbSamples : the number of values to compute from the start to the end of the curve (both included).
+	 * \param result : the sampled values.
+	 *
+	 * \return false if the curves are not sampled by the CurveSampler yet (the preview could differ from the values sent).
+	 */
+	bool sampleCurveSections(const std::vector<float>& percent, const std::vector<float>& y, const std::vector<float>& coeff, unsigned int nbSamples, std::vector<float>& result);
+    
 	/*!
 	 * Adds a new triggerPoint to a box.
      *
@@ -823,6 +1350,31 @@ public:
 	 */
 	void getBoxesId(std::vector<TimeBoxId>& boxesID);
     
+    /*!
+	 * Fills the given vector with the descriptors of all the boxes (except the root box).
+	 * This is faster than calling each box getter for each box.
+	 *
+	 * \param descriptors : the vector to fill with the boxes descriptors.
+	 */
+	void getBoxesDescriptors(std::vector<BoxDescriptor>& descriptors);
+    
+    /*!
+	 * Fills the given vector with the begin and end dates of all the boxes (except the root box).
+	 * Only the dates are read so this is cheaper than getBoxesDescriptors when the boxes are only moved (zoom).
+	 *
+	 * \param dates : the vector to fill with the id and the dates of each box.
+	 */
+	void getBoxesDates(MovedTimeBoxes& dates);
+    
+    /*!
+	 * Fills the given vector with the descriptors of the given boxes.
+	 * Unknown box ids are ignored.
+	 *
+	 * \param boxesID : the boxes to describe.
+	 * \param descriptors : the vector to fill with the boxes descriptors.
+	 */
+	void getBoxesDescriptors(const std::vector<TimeBoxId>& boxesID, std::vector<BoxDescriptor>& descriptors);
+    
 	/*!
 	 * Fills the given vector with all the relations ID used in the editor.
 	 * Useful after a load.
@@ -973,6 +1525,25 @@ public:
 	 */
 	float getCurrentExecutionPosition(TimeBoxId boxId = ROOT_BOX_ID);
     
+    /*!
+	 * Gets the last execution state published by the scheduler callbacks and the sampling thread.
+     * This never calls the scheduler nor waits for it : the GUI reads it once per frame during the execution.
+     *
+     * \note only one thread can call it (the GUI thread) and the reference stays valid until its next call.
+	 *
+	 * \return the execution state.
+	 */
+	const ExecutionState& getExecutionState();
+    
+    /*!
+	 * Processes the scheduler notifications queued since the last call : the time box running state and the trigger point active state
+     * callbacks given to the constructor are called from here, with the last state of each box and trigger point only.
+     * If notifications were lost because too many were queued, the state of all the boxes and trigger points is notified again.
+     *
+     * \note only one thread can call it (the GUI thread, once per frame during the execution).
+	 */
+	void processExecutionEvents();
+    
 	/*!
 	 * Changes the execution speed of a box (default : the main scenario).
 	 *
@@ -989,6 +1560,30 @@ public:
 	 */
 	float getExecutionSpeedFactor(TimeBoxId boxId = ROOT_BOX_ID);
     
+    /*!
+	 * Exports the messages written in the main scenario into a trace file in the order of their date :
+     * the start and end states of the boxes and the values of their curves. Nothing is executed : the scheduler
+     * and the network are not used, so this is not a record of a real execution.
+     *
+     * The export is computed from the score : the trigger points happen at their date without their conditions,
+     * the loops are played once, the execution speed and start point are ignored, the curves are sampled
+     * at their own rate and the muted boxes, states and curves are ignored.
+     * The trace starts with this list of the ignored execution features.
+     *
+     * A csv trace starts with it as a "#" line.
+     * A binary trace starts with "ISTR", its version (uint32), the ignored features (a uint32 length followed by the characters)
+     * and its addresses : their count (uint32) then each id (uint32)
+     * with its address (device/path as a uint32 length followed by the characters).
+     * Each message is then its date in ms (uint32), the id of its address (uint32), a uint8 type and its value :
+     * a float32 for a curve value (type 0) or a string for a state value (type 1, written like the addresses).
+     *
+	 * \param filepath : the path to the trace file to write.
+     * \param format : TraceCSV or TraceBinary.
+     * \param nbMessages : the number of messages written.
+	 * \return 0 if no error, else 1.
+	 */
+	bool exportScore(const std::string& filepath, TraceFormat format, TTUInt64& nbMessages);
+    
     
 	//Network //////////////////////////////////////////////////////////////////////////////////////////////
     
@@ -1070,6 +1665,16 @@ public:
 	 */
 	std::vector<std::string> requestNetworkSnapShot(const std::string & address);
     
+	/*!
+	 * Takes a snapshot of the parameters at several addresses in one pass.
+	 * The addresses are grouped by device so each application directory is accessed once.
+	 *
+	 * \param addresses : the addresses to snapshot.
+	 * \param snapshot : vector to fill with the address and the value of each parameter (the result).
+	 * \param recursive : (optional) true to snapshot all the parameters below each address too.
+	 */
+	void requestNetworkSnapShot(const std::vector<AddressId>& addresses, StateLines& snapshot, bool recursive = false);
+    
 	/*!
 	 * Sends a network namespace request.
 	 * The address must look like this :
@@ -1093,8 +1698,25 @@ public:
                                 std::vector<std::string>& nodes, std::vector<std::string>& leaves,
                                 std::vector<std::string>& attributs, std::vector<std::string>& attributsValue);
 
+    /*!
+     * Gets a whole branch of a namespace in one call : the nodes below an address with their type and their
+     * priority, service, tags, rangeBounds and rangeClipmode attributes.
+     * The value of the parameters is not asked (unlike requestNetworkNamespace). The attributes are the ones each device
+     * is asked to cache (when it is added or loaded) : their mirrors answer them without a request as long as the
+     * protocol fills these caches, which this call doesn't check.
+     *
+     * \param address : the address of the branch. ex : deviceName/address1/address2
+     * \param dump : will be filled with the nodes below the address (sorted by priority then name then instance, each node before its children).
+     * \param recursive : false to get the children of the address only.
+     *
+     * \return True(1) or false(0) if the address doesn't exist.
+     */
+    int requestNetworkNamespaceDump(const std::string & address, NamespaceNodes& dump, bool recursive = true);
+
     /*!
      * Sends a request to get an attribute value.
+     * The type, priority, service, tags, rangeBounds and rangeClipmode attributes are cached (see setAttributeCacheTTL) :
+     * the other ones, as the value, are always read from the namespace.
      *
      * \param address : the object's address. ex : /deviceName/address1/address2/
      * \param attribute : the attribute's name we request. ex : "service", "rangeBounds"...etc
@@ -1135,6 +1757,14 @@ public:
      */
     int requestObjectPriority(const std::string & address, unsigned int & nodeType);
 
+    /*!
+     * Sets how long the attributes of the remote devices (mirror objects) are kept into the attribute cache.
+     * The cache is emptied anyway when a namespace changes (rebuild, loading, learning, ...).
+     *
+     * \param milliseconds : the time to live, 0 to keep them until the next namespace change.
+     */
+    void setAttributeCacheTTL(unsigned int milliseconds);
+
     /*!
      * Sends a request to get the children nodes of an object.
      *
@@ -1147,6 +1777,7 @@ public:
 
     /*!
      * Refresh the namespace by rebuilding the mirror (Minuit protocol case) or reloading the namesapce from the last project file (OSC protocol case)
+     * \note only the namespace of this device is locked until the rebuild ends : the requests about it fail meanwhile instead of waiting for the device.
      *
      * \param deviceName : the device name to rebuild
      * \param address : the object's address
@@ -1162,6 +1793,35 @@ public:
      */
     bool loadNetworkNamespace(const std::string &deviceName, const std::string &filepath);
     
+    /*!
+     * Store the namespace of a device into a binary cache file
+     * (the address and the cached attributes of each parameter, the device name, its protocol and a hash of the namespace)
+     *
+     * \param deviceName : the device name
+     * \param filepath : the path to the cache file to write
+     * \return 0 if no error, else 1.
+     */
+    bool storeNetworkNamespaceCache(const std::string &deviceName, const std::string &filepath);
+    
+    /*!
+     * Fill the namespace of a device from a binary cache file without querying the device
+     * (the cache is ignored if it was stored for another device name or protocol)
+     *
+     * \param deviceName : the device name to setup
+     * \param filepath : the path to a cache file written by storeNetworkNamespaceCache
+     * \return 0 if no error, else 1.
+     */
+    bool loadNetworkNamespaceCache(const std::string &deviceName, const std::string &filepath);
+    
+    /*!
+     * Check if the current namespace of a device is the one loaded from its cache
+     * (used after a rebuild to know if the device changed since the cache was stored)
+     *
+     * \param deviceName : the device name
+     * \return true if a cache was loaded for this device and the namespace hash didn't change.
+     */
+    bool isNetworkNamespaceCacheValid(const std::string &deviceName);
+    
     /*!
      * append a new address to a network device
      *
@@ -1285,7 +1945,7 @@ public:
 	 * Store Engine.
 	 *
 	 * \param filepath : the filepath to use.
-     * \return 1 if the storage succeed
+     * \return 1 if the storage succeed (0 while the namespace of a device is being rebuilt)
 	 */
 	int store(std::string filepath);
     
@@ -1296,7 +1956,7 @@ public:
      * \return 1 if the load succeed
 	 */
 	int load(std::string filepath);
-    void buildEngineCaches(TTObject& scenario, TTAddress& scenarioAddress);
+    void buildEngineCaches(TTObject& scenario, TTAddress& scenarioAddress, TimeBoxId scenarioId);
     void buildConditionedTimeBoxCache(TimeBoxId boxId, TTObject& startEvent, TTObject& endEvent, std::map<TTObjectBasePtr, TimeConditionId> TTCondToID);
     
 	/*!
@@ -1311,6 +1971,7 @@ public:
     friend void AutomationEndCallback(const TTValue& baton, const TTValue& value);
     friend void TriggerReceiverValueCallback(const TTValue& baton, const TTValue& value);
     friend void NamespaceCallback(const TTValue& baton, const TTValue& value);
+    friend void TransportDataValueCallback(const TTValue& baton, const TTValue& value);
     
 private:
     
@@ -1363,4 +2024,10 @@ void AutomationEndCallback(const TTValue& baton, const TTValue& value);
  @return                an error code */
 void NamespaceCallback(const TTValue& baton, const TTValue& value);
 
+/** Callback used each time a /Transport data receives a value
+ @param	baton			an EnginePtr and the name of the transport feature
+ @param	value			the received value
+ @return                an error code */
+void TransportDataValueCallback(const TTValue& baton, const TTValue& value);
+
 #endif // __SCORE_ENGINE_H__
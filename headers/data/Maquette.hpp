@@ -262,6 +262,15 @@ class Maquette : public QTimer
      */
     std::vector<std::string> requestNetworkSnapShot(const std::string &address);
 
+    /*!
+     * \brief Requests a snapshot of several addresses in one pass to the Engines.
+     *
+     * \param addresses : the addresses to be snapped.
+     * \param snapshot : the snapshot taken (only the parameters are snapped).
+     * \param recursive : true to snap all the parameters below each address too.
+     */
+    void requestNetworkSnapShot(const std::vector<AddressId> &addresses, StateLines &snapshot, bool recursive = false);
+
     /*!
      * \brief Adds a curve at specified address.
      *
@@ -329,7 +338,7 @@ class Maquette : public QTimer
      * \param argPosition : the index of the curve
      * \param sampleRate : the sample rate to be set
      * \param redundancy : the redundancy to be set
-     * \param values : the breakpoints' values to be set for y-axis
+     * \param values : the sampled values of the curve, shared with the Engines cache (NULL if the curve can't be sampled)
      * \param argTypes : the respective types of the values to be set
      * \param xPercents : the values to be set for x-axis in percents (0 < % < 100)
      * \param yValues : y-axis values to be set
@@ -339,11 +348,24 @@ class Maquette : public QTimer
      * \return if curves were set correctly
      */
     bool getCurveAttributes(unsigned int boxID, const std::string &address, unsigned int argPosition, unsigned int & sampleRate,
-                            bool &redundancy, bool &interpolate, std::vector<float>& values, std::vector<std::string> &, std::vector<float> &xPercents,
+                            bool &redundancy, bool &interpolate, CurveSamples& values, std::vector<std::string> &, std::vector<float> &xPercents,
                             std::vector<float> &yValues, std::vector<short> &sectionType, std::vector<float> &coeff);
 
     bool getCurveValues(unsigned int boxID, const std::string &address, unsigned int argPosition, std::vector<float> &values);
 
+    /*!
+     * \brief Gets the sampled values of a curve without copying them (they are cached by the engine until the curve changes).
+     */
+    bool getCurveValues(unsigned int boxID, const std::string &address, unsigned int argPosition, CurveSamples &values);
+
+    /*!
+     * \brief Samples curve sections locally as the engines will sample them once they are set (to preview a curve being edited).
+     *
+     * \return false if the engines can't tell the preview matches the values they send (nothing is previewed then)
+     */
+    bool sampleCurveSections(const std::vector<float> &xPercents, const std::vector<float> &yValues, const std::vector<float> &coeff,
+                             unsigned int nbSamples, std::vector<float> &values);
+
     /*!
      * \brief Raised when execution is finished
      */
@@ -398,9 +420,9 @@ class Maquette : public QTimer
      *
      * \param messages : message to sort
      *
-     * \return if itemsSelected could be set
+     * \return the state of the messages sorted
      */
-    std::vector<std::string> sortByPriority(NetworkMessages *messages);
+    StateLines sortByPriority(NetworkMessages *messages);
     static int compareByPriority(const QPair<QTreeWidgetItem *, std::string> v1, const QPair<QTreeWidgetItem *, std::string> v2);
 
 
@@ -710,8 +732,9 @@ class Maquette : public QTimer
      * \brief Saves the current composition into a file.
      *
      * \param fileName : the file to save current composition into
+     * \return false if a device was refreshing its namespace (nothing is saved)
      */
-    void save(const std::string &fileName);
+    bool save(const std::string &fileName);
 
     /*!
      * \brief Loads a file into a new composition.
@@ -734,6 +757,20 @@ class Maquette : public QTimer
      */
     float getPosition(unsigned int boxID);
 
+    /*!
+     * \brief Gets the last execution state published by the engine (GUI thread only).
+     * It doesn't wait for the scheduler : read it once per frame during the execution.
+     *
+     * \return the execution state, valid until the next call
+     */
+    const ExecutionState &getExecutionState();
+
+    /*!
+     * \brief Processes the scheduler notifications queued by the engine (GUI thread only) :
+     * the running state of the boxes and the active state of the trigger points are updated from here.
+     */
+    void processExecutionEvents();
+
     /*!
      * \brief Requests a snapshot of the network on a namespace.
      *
@@ -746,10 +783,20 @@ class Maquette : public QTimer
      */
     int requestNetworkNamespace(const std::string &address, std::string &nodeType, std::vector<std::string>& nodes, std::vector<std::string>& leaves,
                                 std::vector<std::string>& attributes, std::vector<std::string>& attributesValue);
+
+    /*!
+     * \brief Gets the nodes below an address with their type and their cached attributes in one call.
+     *
+     * \param address : the address of the branch
+     * \param dump : the nodes to be filled (each node before its children)
+     * \param recursive : false to get the children of the address only
+     */
+    int requestNetworkNamespaceDump(const std::string &address, NamespaceNodes &dump, bool recursive = true);
     /*!
      * \brief Refresh the network's namespace.
+     * \return 0 if no error, else 1 (see Engine::rebuildNetworkNamespace).
      */
-    void rebuildNetworkNamespace(const std::string &application);
+    bool rebuildNetworkNamespace(const std::string &application);
 
     /*!
      * \brief Requests a snapshot of the network on a namespace.
@@ -794,6 +841,16 @@ class Maquette : public QTimer
     bool setDeviceLearn(std::string deviceName, bool newLearn);
 
     bool loadNetworkNamespace(const string &application, const string &filepath);
+
+    /*!
+     * \brief Stores the namespace of a device into its cache file next to the last saved or loaded project.
+     */
+    void storeNetworkNamespaceCache(const string &application);
+
+    /*!
+     * \brief Checks if the namespace of a device didn't change since its cache was stored.
+     */
+    bool isNetworkNamespaceCacheValid(const string &application);
     int appendToNetWorkNamespace(const std::string & address, const std::string & service = "parameter", const std::string & type = "generic", const std::string & priority = "0", const std::string & description = "", const std::string & range = "0. 1.", const std::string & clipmode = "none", const std::string & tags = "");
     int removeFromNetWorkNamespace(const std::string & address);
 	
@@ -804,22 +861,16 @@ class Maquette : public QTimer
 	{ return _engines->workingProtocols(); }
 	
 	signals:
-		 void boxIsRunningSignal(unsigned int boxId, bool running);
 		 void deviceConnectionFailed(QString, QString);
 	
-		 void triggerPointIsActiveSignal(unsigned int trgID, bool active);
 		 void playOrResumeSignal();
 		 void stopOrPauseSignal();
+		 void pauseOrResumeSignal();
+		 void rewindSignal();
 		 void changeTimeOffsetSignal(unsigned int);
 		 void changeSpeedSignal(double);
   
   public slots:
-    /*
-     * It is necessary to put this in a slot in order to prevent a crash due to inter-thread 
-     * mechanism of qt. 
-     */ 
-
-    void boxIsRunningSlot(unsigned int boxId, bool running);
     /*!
      * \brief Sets the time offset value in ms where the engine will start from at the nex execution. The boolean "mute" mutes or not the dump of all messages (the scene state at timeOffset).
      */
@@ -1010,17 +1061,17 @@ class Maquette : public QTimer
     /*!
      * \brief Update curves for a box by specifying star end end messages.
      *
-     * \param startMsgs : the start messages of the box
-     * \param endMsgs : the end messages of the box
+     * \param startState : the start state of the box
+     * \param endState : the end state of the box
      */
-    void updateCurves(unsigned int boxID, const std::vector<std::string> &startMsgs, const std::vector<std::string> &endMsgs);
+    void updateCurves(unsigned int boxID, const StateLines &startState, const StateLines &endState);
 
     /*!
      * \brief Updates a set of boxes from Engines coordinates.
      *
-     * \param movedBoxes : boxes to be updated
+     * \param movedBoxes : boxes to be updated with their new dates
      */
-    void updateBoxesFromEngines(const std::vector<unsigned int> &movedBoxes);
+    void updateBoxesFromEngines(const MovedTimeBoxes &movedBoxes);
 
     //! The MaquetteScene managing display and interaction.
     MaquetteScene *_scene;
@@ -1047,6 +1098,14 @@ class Maquette : public QTimer
 //  unsigned int _currentID;
     std::string _currentDevice;
 
+    //! The last saved or loaded project file (the namespace caches of the devices are stored next to it).
+    std::string _projectFileName;
+
+    /*!
+     * \brief Gets the path of the namespace cache file of a device.
+     */
+    std::string namespaceCacheFile(const std::string &deviceName) const;
+
     //! The set of handled devices.
     std::map<std::string, MyDevice> _devices;
 
@@ -1072,6 +1131,7 @@ class Maquette : public QTimer
 
 /*!
  * \brief Callback called when a Trigger Point active state change
+ * It is called on the GUI thread by Engine::processExecutionEvents.
  *
  * \param trgID : index of the box's Trigger Point
  * \param waiting : the active state of the Trigger Point
@@ -1080,6 +1140,7 @@ void triggerPointIsActiveCallback(unsigned int trgID, bool active);
 
 /*!
  * \brief Callback called when the running state of a box change.
+ * It is called on the GUI thread by Engine::processExecutionEvents.
  *
  * \param boxID : the box whose changing his running status
  * \param running : the new running state of the box
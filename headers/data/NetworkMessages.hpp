@@ -13,6 +13,7 @@
 #include <string>
 #include <QStringList>
 #include <QTreeWidgetItem>
+#include "AddressTable.hpp"
 
 using std::string;
 
@@ -129,6 +130,12 @@ class NetworkMessages : public QObject {
     inline Message getMessage(QTreeWidgetItem *item){return _messages.value(item); }
     std::string computeMessage(const Message &msg);
     std::string computeMessageWithoutValue(const Message &msg);
+
+    /*!
+     * \brief Gets the id of the message address (device/message) in the AddressTable.
+     * \param msg : the message
+     */
+    AddressId addressId(const Message &msg);
     inline QList<Message> messages(){ return _messages.values(); }
     QMap<QString, QString> toMapAddressValue();
     inline bool
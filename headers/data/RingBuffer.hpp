@@ -0,0 +1,107 @@
+/*
+ * Lock-free ring buffer shared by several producers and one consumer
+ * Copyright © 2026, agent
+ *
+ * License: This code is licensed under the terms of the "CeCILL-C"
+ * http://www.cecill.info
+ */
+
+#ifndef RING_BUFFER_HPP
+#define RING_BUFFER_HPP
+
+/*!
+ * \file RingBuffer.hpp
+ * \author agent
+ * \date 2026
+ *
+ * \brief This file contains a fixed size queue used to pass small events from threads to another one without locking.
+ *
+ */
+
+#include <atomic>
+
+/*!
+ * \class RingBuffer
+ *
+ * \brief A multiple producers single consumer queue of Capacity elements.
+ *
+ * push and pop never lock : push returns false when the queue is full and pop returns false when it is empty.
+ * The elements are copied so they should be small plain types.
+ *
+ * Any thread can push. Only one thread at a time can pop.
+ *
+ * Each cell has a sequence number telling whether it is free for the push number n (sequence == n)
+ * or holds the element of the push number n (sequence == n + 1), so the producers only compete
+ * for the tail with a compare and swap and never wait for each other.
+ */
+template <typename T, unsigned int Capacity>
+class RingBuffer {
+
+    static_assert(Capacity != 0 && (Capacity & (Capacity - 1)) == 0, "the capacity of a RingBuffer has to be a power of two");
+
+    struct Cell {
+        std::atomic<unsigned int>   sequence;
+        T                           element;
+    };
+
+    Cell                        m_cells[Capacity];
+    std::atomic<unsigned int>   m_head;             /// the number of elements popped (consumer side)
+    std::atomic<unsigned int>   m_tail;             /// the number of cells claimed by the producers
+
+public:
+
+    RingBuffer() : m_head(0), m_tail(0)
+    {
+        for (unsigned int i = 0; i < Capacity; i++)
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    /** append an element (producer side) : false if the queue is full */
+    bool push(const T& element)
+    {
+        unsigned int tail = m_tail.load(std::memory_order_relaxed);
+        Cell* cell;
+
+        for (;;) {
+
+            cell = &m_cells[tail & (Capacity - 1)];
+
+            int diff = int(cell->sequence.load(std::memory_order_acquire) - tail);
+
+            // the cell is free : claim it (on failure tail is reloaded)
+            if (diff == 0) {
+                if (m_tail.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed))
+                    break;
+            }
+            // the cell still holds the element pushed Capacity times ago
+            else if (diff < 0)
+                return false;
+            // another producer claimed it first
+            else
+                tail = m_tail.load(std::memory_order_relaxed);
+        }
+
+        cell->element = element;
+        cell->sequence.store(tail + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /** remove the oldest element (consumer side) : false if the queue is empty or its oldest cell is still being written */
+    bool pop(T& element)
+    {
+        unsigned int head = m_head.load(std::memory_order_relaxed);
+        Cell* cell = &m_cells[head & (Capacity - 1)];
+
+        if (int(cell->sequence.load(std::memory_order_acquire) - (head + 1)) < 0)
+            return false;
+
+        element = cell->element;
+        cell->sequence.store(head + Capacity, std::memory_order_release);
+        m_head.store(head + 1, std::memory_order_relaxed);
+
+        return true;
+    }
+};
+
+#endif // RING_BUFFER_HPP
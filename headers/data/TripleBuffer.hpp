@@ -0,0 +1,68 @@
+/*
+ * Lock-free triple buffer shared by one writer and one reader
+ * Copyright © 2026, agent
+ *
+ * License: This code is licensed under the terms of the "CeCILL-C"
+ * http://www.cecill.info
+ */
+
+#ifndef TRIPLE_BUFFER_HPP
+#define TRIPLE_BUFFER_HPP
+
+/*!
+ * \file TripleBuffer.hpp
+ * \author agent
+ * \date 2026
+ *
+ * \brief This file contains a triple buffer used to pass the last state computed by a thread to another one without locking.
+ *
+ */
+
+#include <atomic>
+
+/*!
+ * \class TripleBuffer
+ *
+ * \brief Passes the last published value from one writer thread to one reader thread.
+ *
+ * The writer fills the back slot then publishes it : the back slot is exchanged with the middle one.
+ * The reader gets the front slot after exchanging it with the middle one if something new was published.
+ * Neither side ever waits for the other and the reader always gets a complete value (the last published one).
+ *
+ * Only one thread at a time can write and only one thread can read.
+ */
+template <typename T>
+class TripleBuffer {
+
+    static const unsigned int INDEX_MASK = 3u;
+    static const unsigned int DIRTY = 4u;           /// set in m_middle when the middle slot holds a value not read yet
+
+    T                           m_slots[3];
+    std::atomic<unsigned int>   m_middle;           /// the index of the middle slot and the DIRTY flag
+    unsigned int                m_back;             /// the slot owned by the writer
+    unsigned int                m_front;            /// the slot owned by the reader
+
+public:
+
+    TripleBuffer() : m_middle(1), m_back(0), m_front(2) {}
+
+    /** the slot to fill before publish (writer side) */
+    T& back() { return m_slots[m_back]; }
+
+    /** make the back slot the last published value (writer side) : the new back slot contains an older value */
+    void publish()
+    {
+        m_back = m_middle.exchange(m_back | DIRTY, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    /** get the last published value (reader side) : the reference stays valid until the next read */
+    const T& read()
+    {
+        if (m_middle.load(std::memory_order_relaxed) & DIRTY)
+            m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & INDEX_MASK;
+
+        return m_slots[m_front];
+    }
+};
+
+#endif // TRIPLE_BUFFER_HPP
@@ -68,9 +68,13 @@ headers/data/AbstractCurve.hpp \
 headers/data/AbstractRelation.hpp \
 headers/data/AbstractParentBox.hpp \
 headers/data/AbstractTriggerPoint.hpp \
+headers/data/AddressTable.hpp \
+headers/data/CurveSampler.hpp \
 headers/data/Engine.h \
 headers/data/Maquette.hpp \
 headers/data/NetworkMessages.hpp \
+headers/data/RingBuffer.hpp \
+headers/data/TripleBuffer.hpp \
 headers/GUI/AttributesEditor.hpp \
 headers/GUI/BasicBox.hpp \
 headers/GUI/Comment.hpp \
@@ -104,6 +108,8 @@ src/data/AbstractCurve.cpp \
 src/data/AbstractParentBox.cpp \
 src/data/AbstractRelation.cpp \
 src/data/AbstractTriggerPoint.cpp \
+src/data/AddressTable.cpp \
+src/data/CurveSampler.cpp \
 src/data/Engine.cpp \
 src/data/Maquette.cpp \
 src/data/NetworkMessages.cpp \
@@ -414,6 +414,7 @@ BasicBox::init()
 {
   _shift = false;
   _playing = false;
+  _progress = 0.;
   _recording = true;
   _mute = false;
   _loop = false;
@@ -971,10 +972,27 @@ BasicBox::setCrossedExtremity(BoxExtremity extremity)
   else if (extremity == BOX_END)
     _playing = false;
 
+  _progress = 0.;
   _scene->setPlaying(_abstract->ID(), _playing);
   update();
 }
 
+void
+BasicBox::updateProgressBar(float progress)
+{
+  if (progress == _progress) {
+      return;
+    }
+
+  // the band covers the line and the bar drawn by paint (3 pixels wide pen)
+  const float margin = 3.;
+  const float left = _boxRect.left() + std::min(progress, _progress) * _abstract->width() - margin;
+  const float right = _boxRect.left() + std::max(progress, _progress) * _abstract->width() + margin;
+
+  _progress = progress;
+  update(QRectF(left, _boxRect.top() - margin, right - left, _boxRect.height() + 2 * margin));
+}
+
 bool
 BasicBox::hasTriggerPoint(BoxExtremity extremity)
 {
@@ -2082,7 +2100,7 @@ BasicBox::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidg
         painter->setPen(pen);
         brush.setColor(Qt::blue);
         painter->setBrush(brush);
-        const float progressPosX = _scene->getPosition(_abstract->ID()) * (_abstract->width());
+        const float progressPosX = _progress * _abstract->width();
         painter->fillRect(0, _abstract->height() - RESIZE_TOLERANCE / 2., progressPosX, RESIZE_TOLERANCE / 2., Qt::darkGreen);
         painter->drawLine(QPointF(progressPosX, RESIZE_TOLERANCE), QPointF(progressPosX, _abstract->height()));
     }
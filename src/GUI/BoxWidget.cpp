@@ -336,12 +336,13 @@ BoxWidget::updateCurve(const string &address, bool forceUpdate)
 
           unsigned int sampleRate;
           bool redundancy, interpolate;
-          vector<float> values, xPercents, yValues, coeff;
+          CurveSamples values;
+          vector<float> xPercents, yValues, coeff;
           vector<string> argTypes;
           vector<short> sectionType;
 
           bool getCurveSuccess = Maquette::getInstance()->getCurveAttributes(_boxID, address, 0, sampleRate, redundancy, interpolate, values, argTypes, xPercents, yValues, sectionType, coeff);
-          bool getCurveValuesSuccess = Maquette::getInstance()->getCurveValues(_boxID, address, 0, yValues);
+          bool getCurveValuesSuccess = values != nullptr;
 
           //--- PRINT ---
 //            std::cout<<"values : "<<std::endl;
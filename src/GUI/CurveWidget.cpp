@@ -67,6 +67,7 @@ using std::make_pair;
 #include "NetworkTree.hpp"
 
 #define BORDER_WIDTH 2.
+#define COMMIT_INTERVAL 100 // ms between two commits to the Engines while dragging
 
 CurveWidget::CurveWidget(QWidget *parent) : QWidget(parent)
 {
@@ -85,7 +86,7 @@ CurveWidget::~CurveWidget() {}
 void
 CurveWidget::init()
 {
-	_abstract = new AbstractCurve(NO_ID, "", 0, 10, false, true, true, 1, vector<float>(), map<float, pair<float, float> >());
+	_abstract = new AbstractCurve(NO_ID, "", 0, 10, false, true, true, 1, CurveSamples(), map<float, pair<float, float> >());
 	
 	setCursor(Qt::CrossCursor);
 	setMouseTracking(true);
@@ -110,12 +111,17 @@ CurveWidget::init()
 	_lastPowSave = 1.;
 	setLayout(_layout);
 	_xAxisPos = height() / 2.;
+	_curvePathOutdated = true;
 	
 	_minYTextRect = new QRectF(0.,_xAxisPos,40.,10.);
 	_maxYTextRect = new QRectF(0.,0.,40.,10.);
 	
 	_minRangeBoundLocked = false;
 	_maxRangeBoundLocked = false;
+	
+	_commitTimer.setSingleShot(true);
+	_commitTimer.setInterval(COMMIT_INTERVAL);
+	connect(&_commitTimer, SIGNAL(timeout()), this, SLOT(commitCurve()));
 }
 
 AbstractCurve *
@@ -127,8 +133,8 @@ CurveWidget::abstractCurve()
 void
 CurveWidget::curveRepresentationOutdated()
 {
-	float maxCurveElement = *(std::max_element(_abstract->_curve.begin(), _abstract->_curve.end()));
-	float minCurveElement = *(std::min_element(_abstract->_curve.begin(), _abstract->_curve.end()));
+	float maxCurveElement = *(std::max_element(_abstract->_curve->begin(), _abstract->_curve->end()));
+	float minCurveElement = *(std::min_element(_abstract->_curve->begin(), _abstract->_curve->end()));
 	
 	
 	std::vector<float> range;
@@ -154,18 +160,19 @@ CurveWidget::curveRepresentationOutdated()
 		_xAxisPos = (height() - BORDER_WIDTH) / 2.;
 	}
 	
-	_interspace = (width() - BORDER_WIDTH) / (float)(std::max((unsigned int)2, (unsigned int)(_abstract->_curve.size())) - 1);
+	_interspace = (width() - BORDER_WIDTH) / (float)(std::max((unsigned int)2, (unsigned int)(_abstract->_curve->size())) - 1);
 	
 	float halfSizeY = std::max(fabs(_maxY), fabs(_minY));
 	_scaleY = (_xAxisPos - BORDER_WIDTH) / halfSizeY;
 	// qDebug() <<"Scale: " << _scaleY;
+	_curvePathOutdated = true;
 	update();
 }
 
 void CurveWidget::adaptScale()
 {
-	_maxY = *(std::max_element(_abstract->_curve.begin(), _abstract->_curve.end()));
-	_minY = *(std::min_element(_abstract->_curve.begin(), _abstract->_curve.end()));
+	_maxY = *(std::max_element(_abstract->_curve->begin(), _abstract->_curve->end()));
+	_minY = *(std::min_element(_abstract->_curve->begin(), _abstract->_curve->end()));
 	
 	const double min_spacing{0.1};
 	if(std::abs(_maxY - _minY) < min_spacing)
@@ -178,10 +185,11 @@ void CurveWidget::adaptScale()
 					(height() - BORDER_WIDTH) / 2.;
 	
 	_interspace = (width() - BORDER_WIDTH) / (float)(std::max((unsigned int)2, 
-															  (unsigned int)(_abstract->_curve.size())) - 1);
+															  (unsigned int)(_abstract->_curve->size())) - 1);
 	
 	float halfSizeY = std::max(fabs(_maxY), fabs(_minY));
 	_scaleY = 2 * (_xAxisPos - BORDER_WIDTH) / (2 * halfSizeY);
+	_curvePathOutdated = true;
 	
 	update();
 }
@@ -191,7 +199,7 @@ void
 CurveWidget::setAttributes(unsigned int boxID,
 						   const std::string &address,
 						   unsigned int argPosition,
-						   const vector<float> &values,
+						   const CurveSamples &values,
 						   unsigned int sampleRate,
 						   bool redundancy,
 						   bool show,
@@ -206,7 +214,6 @@ CurveWidget::setAttributes(unsigned int boxID,
 	Q_UNUSED(sectionType);
 	
 	_abstract->_boxID = boxID;
-	_abstract->_curve.clear();
 	_abstract->_breakpoints.clear();
 	_abstract->_sampleRate = sampleRate;
 	
@@ -215,10 +222,8 @@ CurveWidget::setAttributes(unsigned int boxID,
 	_abstract->_interpolate = interpolate;
 	_abstract->_address = address;
 	
-	vector<float>::const_iterator it;
-	for (it = values.begin(); it != values.end(); ++it) {
-		_abstract->_curve.push_back(*it);
-	}
+	// share the values sampled by the Engines
+	_abstract->_curve = values ? values : std::make_shared<std::vector<float> >();
 	
 	for (unsigned int i = 0; i < xPercents.size(); ++i) {
 		_abstract->_breakpoints[xPercents[i] / 100.] = pair<float, float>(yValues[i], coeff[i]);
@@ -231,7 +236,7 @@ void
 CurveWidget::setAttributes(unsigned int boxID,
 						   const std::string &address,
 						   unsigned int /*argPosition*/,
-						   const vector<float> &values,
+						   const CurveSamples &values,
 						   unsigned int sampleRate,
 						   bool redundancy,
 						   bool show,
@@ -341,7 +346,7 @@ CurveWidget::mousePressEvent(QMouseEvent *event)
 						_abstract->_breakpoints.erase(it);
 					}
 					_savedMap = _abstract->_breakpoints;
-					curveChanged();
+					curveEdited();
 					update();
 					break;
 				}
@@ -363,7 +368,7 @@ CurveWidget::mousePressEvent(QMouseEvent *event)
 							_abstract->_breakpoints.erase(it);
 						}
 						_savedMap = _abstract->_breakpoints;
-						curveChanged();
+						curveEdited();
 						update();
 						break;
 					}
@@ -463,7 +468,7 @@ CurveWidget::mouseMoveEvent(QMouseEvent *event)
 						
 						it->second = std::make_pair(it->second.first, pow);
 						_movingBreakpointY = -1;
-						curveChanged();
+						curveEdited();
 					}
 				}
 				break;
@@ -472,7 +477,7 @@ CurveWidget::mouseMoveEvent(QMouseEvent *event)
 			case Qt::ControlModifier: // Draw mode
 			{
 				_abstract->_breakpoints[relativePoint.x()] = std::make_pair<float, float>(relativePoint.y(), 1.);
-				curveChanged();
+				curveEdited();
 				
 				break;
 			}
@@ -487,7 +492,7 @@ CurveWidget::mouseMoveEvent(QMouseEvent *event)
 				_abstract->_breakpoints[static_cast<qreal>(relativePoint.x())] = 
 						std::make_pair<float, float>(static_cast<qreal>(_movingBreakpointY),
 													 static_cast<qreal>(_lastPowSave));
-				curveChanged();
+				curveEdited();
 				update();
 				
 				
@@ -506,7 +511,7 @@ CurveWidget::mouseMoveEvent(QMouseEvent *event)
 						_abstract->_breakpoints.erase(it);
 						_movingBreakpointX = -1.;
 						_movingBreakpointY = -1.;
-						curveChanged();
+						curveEdited();
 						update();
 						break;
 					}
@@ -518,7 +523,7 @@ CurveWidget::mouseMoveEvent(QMouseEvent *event)
 			{
 				_movingBreakpointX = -1;
 				_movingBreakpointY = -1;
-				curveChanged();
+				curveEdited();
 				update();
 				break;
 			}
@@ -533,6 +538,10 @@ CurveWidget::mouseReleaseEvent(QMouseEvent *event)
 {
 	QWidget::mouseReleaseEvent(event);
 	
+	// the curve edited while dragging is sent now
+	bool commitPending = _commitTimer.isActive();
+	_commitTimer.stop();
+	
 	if (_clicked) {
 		if (event->modifiers() == Qt::NoModifier && !_shiftModifierWasEnabled) {
 			QPointF relativePoint = relativeCoordinates(event->pos());
@@ -584,6 +593,9 @@ CurveWidget::mouseReleaseEvent(QMouseEvent *event)
 			update();
 			
 		}
+		else if (commitPending) {
+			curveChanged();
+		}
 	}
 	
 	_clicked = false;
@@ -595,13 +607,9 @@ CurveWidget::mouseReleaseEvent(QMouseEvent *event)
 	update();
 }
 
-bool
-CurveWidget::curveChanged()
+void
+CurveWidget::breakpointsToSections(vector<float> &xPercents, vector<float> &yValues, vector<short> &sectionType, vector<float> &coeff)
 {
-	vector<float> xPercents;
-	vector<float> yValues;
-	vector<short> sectionType;
-	vector<float> coeff;
 	map<float, pair<float, float> >::iterator it;
 	
 	for (it = _abstract->_breakpoints.begin(); it != _abstract->_breakpoints.end(); ++it) {
@@ -611,6 +619,17 @@ CurveWidget::curveChanged()
 		coeff.push_back(it->second.second);
 		sectionType.push_back(CURVE_POW);
 	}
+}
+
+bool
+CurveWidget::curveChanged()
+{
+	vector<float> xPercents;
+	vector<float> yValues;
+	vector<short> sectionType;
+	vector<float> coeff;
+	
+	breakpointsToSections(xPercents, yValues, sectionType, coeff);
 	
 	if (Maquette::getInstance()->setCurveSections(_abstract->_boxID, 
 												  _abstract->_address, 
@@ -622,7 +641,7 @@ CurveWidget::curveChanged()
 		unsigned int sampleRate;
 		bool redundancy, interpolate;
 		vector<string> argTypes;
-		vector<float> values;
+		CurveSamples values;
 		xPercents.clear();
 		yValues.clear();
 		sectionType.clear();
@@ -668,6 +687,40 @@ CurveWidget::curveChanged()
 	return false;
 }
 
+void
+CurveWidget::previewCurve()
+{
+	vector<float> xPercents;
+	vector<float> yValues;
+	vector<short> sectionType;
+	vector<float> coeff;
+	
+	breakpointsToSections(xPercents, yValues, sectionType, coeff);
+	
+	// keep the resolution of the last curve sent by the Engines (the shared values are not modified)
+	std::shared_ptr<std::vector<float> > preview = std::make_shared<std::vector<float> >();
+	
+	if (Maquette::getInstance()->sampleCurveSections(xPercents, yValues, coeff, std::max((size_t)2, _abstract->_curve->size()), *preview)) {
+		_abstract->_curve = preview;
+		curveRepresentationOutdated();
+	}
+}
+
+void
+CurveWidget::curveEdited()
+{
+	previewCurve();
+	
+	if (!_commitTimer.isActive())
+		_commitTimer.start();
+}
+
+void
+CurveWidget::commitCurve()
+{
+	curveChanged();
+}
+
 void
 CurveWidget::applyChanges()
 {
@@ -681,10 +734,69 @@ CurveWidget::resizeEvent(QResizeEvent * event)
 	curveRepresentationOutdated();
 }
 
+void
+CurveWidget::updateCurvePath()
+{
+	const vector<float> &curve = *_abstract->_curve;
+	float step = _interspace * _scaleX;
+	
+	_curvePath = QPainterPath();
+	_curvePathOutdated = false;
+	
+	if (curve.empty())
+		return;
+	
+	_curvePath.moveTo(0., _xAxisPos - curve.front() * _scaleY);
+	
+	// few samples : draw them all
+	if (step >= 1. || curve.size() < 3) 
+	{
+		for (unsigned int i = 1; i < curve.size(); ++i)
+			_curvePath.lineTo(i * step, _xAxisPos - curve[i] * _scaleY);
+		
+		return;
+	}
+	
+	// many samples : keep the minimum and the maximum of each pixel column in the order they come
+	int column = 0;
+	unsigned int minIndex = 0, maxIndex = 0;
+	
+	for (unsigned int i = 1; i <= curve.size(); ++i) 
+	{
+		int currentColumn = i < curve.size() ? (int)(i * step) : column + 1;
+		
+		if (currentColumn != column) 
+		{
+			unsigned int first = std::min(minIndex, maxIndex);
+			unsigned int second = std::max(minIndex, maxIndex);
+			
+			_curvePath.lineTo(first * step, _xAxisPos - curve[first] * _scaleY);
+			if (second != first)
+				_curvePath.lineTo(second * step, _xAxisPos - curve[second] * _scaleY);
+			
+			if (i == curve.size())
+				break;
+			
+			column = currentColumn;
+			minIndex = maxIndex = i;
+		}
+		else 
+		{
+			if (curve[i] < curve[minIndex])
+				minIndex = i;
+			if (curve[i] > curve[maxIndex])
+				maxIndex = i;
+		}
+	}
+	
+	// end exactly on the last sample
+	_curvePath.lineTo((curve.size() - 1) * step, _xAxisPos - curve.back() * _scaleY);
+}
+
 void CurveWidget::paintEvent(QPaintEvent * /* event */)
 {        
-	QPainter *painter = new QPainter(this);
-	painter->setRenderHint(QPainter::Antialiasing, true);
+	QPainter painter(this);
+	painter.setRenderHint(QPainter::Antialiasing, true);
 	static const QColor BASE_COLOR(Qt::black);
 	static const QColor AXE_COLOR(Qt::black);
 	
@@ -698,97 +810,89 @@ void CurveWidget::paintEvent(QPaintEvent * /* event */)
 	// Abcisses line
 	QPen penXAxis((_unactive) ? UNACTIVE_COLOR : AXE_COLOR);
 	
-	painter->setPen(penXAxis);
-	painter->drawLine(0, _xAxisPos, width(), _xAxisPos);
+	painter.setPen(penXAxis);
+	painter.drawLine(0, _xAxisPos, width(), _xAxisPos);
 	
-	painter->setPen(BASE_COLOR);
+	painter.setPen(BASE_COLOR);
 	
-	vector<float>::iterator it;
 	map<float, pair<float, float> >::iterator it2;
 	float pointSizeX = 6;
 	float pointSizeY = 6;
+	QSizeF pointSize(pointSizeX, pointSizeY);
+	QPointF halfPointSize(pointSizeX / 2., pointSizeY / 2.);
 	QPointF curPoint(0, 0);
-	QPointF precPoint(-1, -1);
 	
-	unsigned int i = 0;
+	if (_curvePathOutdated)
+		updateCurvePath();
 	
-	for (it = _abstract->_curve.begin(); it != _abstract->_curve.end(); ++it) 
+	if (!_abstract->_curve->empty()) 
 	{
-		curPoint = absoluteCoordinates(QPointF(1, *it));
-		curPoint.setX(i * _interspace * _scaleX);
+		// First point is represented by a specific color
+		painter.fillRect(QRectF(QPointF(_curvePath.elementAt(0)) - halfPointSize, pointSize), EXTREMITY_COLOR);
 		
-		if (it == _abstract->_curve.begin()) 
-		{   // First point is represented by a specific color
-			painter->fillRect(QRectF(curPoint - QPointF(pointSizeX / 2., pointSizeY / 2.), QSizeF(pointSizeX, pointSizeY)), EXTREMITY_COLOR);
-		}
+		// Lines between values are drawn at once
+		QPen pen(_unactive ? UNACTIVE_COLOR : CURVE_COLOR);
+		pen.setWidth(_unactive ? 1 : 2);
 		
-		if (precPoint != QPointF(-1, -1)) 
-		{
-			QPen pen(_unactive ? UNACTIVE_COLOR : CURVE_COLOR);
-			pen.setWidth(_unactive ? 1 : 2);
-			
-			painter->setPen(pen);
-			painter->drawLine(precPoint, curPoint);  // Draw lines between values
-			
-			painter->setPen(BASE_COLOR);
-		}
+		painter.setPen(pen);
+		painter.setBrush(Qt::NoBrush);
+		painter.drawPath(_curvePath);
+		painter.setPen(BASE_COLOR);
 		
-		precPoint = curPoint;
-		i++;
+		curPoint = _curvePath.currentPosition();
 	}
 	
 	// Last point is represented by a specific color
 	if (!_unactive) 
 	{
-		painter->fillRect(QRectF(curPoint - QPointF(pointSizeX / 2., pointSizeY / 2.), 
-								 QSizeF(pointSizeX, pointSizeY)), 
-						  EXTREMITY_COLOR);
+		painter.fillRect(QRectF(curPoint - halfPointSize, pointSize), EXTREMITY_COLOR);
+		
+		// Breakpoints are drawn with rectangles in one call
+		QVector<QRectF> breakpoints;
+		breakpoints.reserve(_abstract->_breakpoints.size());
 		
-		precPoint = QPointF(-1, -1);
 		for (it2 = _abstract->_breakpoints.begin(); it2 != _abstract->_breakpoints.end(); ++it2) 
 		{
 			curPoint = absoluteCoordinates(QPointF(it2->first, it2->second.first));
-			
-			// Breakpoints are drawn with rectangles
-			painter->fillRect(QRectF(curPoint - QPointF(pointSizeX / 2., pointSizeY / 2.), 
-									 QSizeF(pointSizeX, pointSizeY)), 
-							  _unactive ? UNACTIVE_COLOR : BREAKPOINT_COLOR);
-			precPoint = curPoint;
+			breakpoints.append(QRectF(curPoint - halfPointSize, pointSize));
 		}
 		
+		painter.setPen(Qt::NoPen);
+		painter.setBrush(_unactive ? UNACTIVE_COLOR : BREAKPOINT_COLOR);
+		painter.drawRects(breakpoints);
+		painter.setBrush(Qt::NoBrush);
+		painter.setPen(BASE_COLOR);
+		
 		if (_movingBreakpointX != -1 && _movingBreakpointY != -1) 
 		{
 			QPointF cursor = absoluteCoordinates(QPointF(_movingBreakpointX, _movingBreakpointY));
 			
 			// If a breakpoint is currently being moved, it is represented by a rectangle
-			painter->fillRect(QRectF(cursor - QPointF(pointSizeX / 2., pointSizeY / 2.), 
-									 QSizeF(pointSizeX, pointSizeY)), 
-							  _abstract->_interpolate ? MOVING_BREAKPOINT_COLOR : UNACTIVE_COLOR);
+			painter.fillRect(QRectF(cursor - halfPointSize, pointSize), 
+							 _abstract->_interpolate ? MOVING_BREAKPOINT_COLOR : UNACTIVE_COLOR);
 		}
 	}
 	
 	//text : minY, maxY
 	if(_minYModified || _maxYModified)
 	{
-		painter->save();
+		painter.save();
 		QFont textFont;
 		textFont.setPointSize(9.);
-		painter->setFont(textFont);
-		painter->setPen(QPen(Qt::black));
+		painter.setFont(textFont);
+		painter.setPen(QPen(Qt::black));
 		if(_minYModified)
 		{
-			painter->drawText(*_minYTextRect,QString("%1").arg(_minY));
+			painter.drawText(*_minYTextRect,QString("%1").arg(_minY));
 			_minYModified = false;
 		}
 		else if(_maxYModified)
 		{
-			painter->drawText(*_maxYTextRect,QString("%1").arg(_maxY));
+			painter.drawText(*_maxYTextRect,QString("%1").arg(_maxY));
 			_maxYModified = false;
 		}
-		painter->restore();
+		painter.restore();
 	}
-	
-	delete painter;
 }
 
 void
@@ -44,7 +44,7 @@ DeviceEdit::DeviceEdit(QWidget *parent)
   setModal(true);
 
   connect(this, SIGNAL(accepted()),
-		  &updater, SLOT(update()));
+		  this, SLOT(startUpdate()));
   _changed = false;
   _nameChanged = false;  
   _protocolChanged = false;
@@ -145,24 +145,41 @@ DeviceEdit::DeviceEdit(QWidget *parent)
   connect(_okButton, SIGNAL(clicked()), this, SLOT(accept()));
   connect(_cancelButton, SIGNAL(clicked()), this, SLOT(reject()));
 
-  connect(this, SIGNAL(accepted()), &updater, SLOT(update()));
-  
-  
+  // the updater runs on its own thread : its results are queued to the GUI thread
+  connect(this,		&DeviceEdit::updateRequested,
+		  &updater, &NetworkUpdater::update, Qt::QueuedConnection);
+  connect(this,		&DeviceEdit::rebuildRequested,
+		  &updater, &NetworkUpdater::rebuildNamespace, Qt::QueuedConnection);
+
   connect(&updater, &NetworkUpdater::deviceChanged,
-		  this,		&DeviceEdit::deviceChanged, Qt::DirectConnection);
+		  this,		&DeviceEdit::deviceChanged, Qt::QueuedConnection);
   connect(&updater, &NetworkUpdater::newDeviceAdded,
-		  this,		&DeviceEdit::newDeviceAdded, Qt::DirectConnection);
+		  this,		&DeviceEdit::newDeviceAdded, Qt::QueuedConnection);
+  connect(&updater, &NetworkUpdater::namespaceLoaded,
+		  this,		&DeviceEdit::namespaceLoaded, Qt::QueuedConnection);
   connect(&updater, &NetworkUpdater::namespaceLoaded,
-		  this,		&DeviceEdit::namespaceLoaded, Qt::DirectConnection);
+		  this,		[this] (QString) { _namespaceFilePath->clear(); });
+  connect(&updater, &NetworkUpdater::namespaceLoadFailed,
+		  this,		[this] (QString message) { QMessageBox::warning(this, "", message); });
+  connect(&updater, &NetworkUpdater::namespaceRebuilt,
+		  this,		&DeviceEdit::namespaceRebuilt, Qt::QueuedConnection);
+  connect(&updater, &NetworkUpdater::namespaceRebuildFailed,
+		  this,		&DeviceEdit::namespaceRebuildFailed, Qt::QueuedConnection);
   connect(&updater, &NetworkUpdater::deviceNameChanged,
-		  this,		&DeviceEdit::deviceNameChanged, Qt::DirectConnection);
+		  this,		&DeviceEdit::deviceNameChanged, Qt::QueuedConnection);
   connect(&updater, &NetworkUpdater::deviceProtocolChanged,
-		  this,		&DeviceEdit::deviceProtocolChanged, Qt::DirectConnection);
-  
+		  this,		&DeviceEdit::deviceProtocolChanged, Qt::QueuedConnection);
+  connect(&updater, &NetworkUpdater::progress,
+		  this,		&DeviceEdit::progress, Qt::QueuedConnection);
+  connect(&updater, &NetworkUpdater::started,
+		  this,		&DeviceEdit::requestStarted, Qt::QueuedConnection);
+  connect(&updater, &NetworkUpdater::finished,
+		  this,		&DeviceEdit::requestFinished, Qt::QueuedConnection);
+
   connect(&updater,  &NetworkUpdater::enableTree,
-		  this,		&DeviceEdit::enableTree, Qt::DirectConnection);
+		  this,		&DeviceEdit::enableTree, Qt::QueuedConnection);
   connect(&updater,  &NetworkUpdater::disableTree,
-		  this,		&DeviceEdit::disableTree, Qt::DirectConnection);
+		  this,		&DeviceEdit::disableTree, Qt::QueuedConnection);
 
   setCorrespondingProtocolLayout();
 }
@@ -401,6 +418,92 @@ DeviceEdit::updateNetworkConfiguration()
 
 }
 
+void
+DeviceEdit::startUpdate()
+{
+  // copy the edited configuration : the dialog can't be read from the updater thread
+  NetworkUpdate request;
+
+  request.newDevice = _newDevice;
+  request.changed = _changed;
+  request.nameChanged = _nameChanged;
+  request.localHostChanged = _localHostChanged;
+  request.networkPortChanged = _networkPortChanged;
+  request.protocolChanged = _protocolChanged;
+  request.namespacePathChanged = _namespacePathChanged;
+
+  request.previousName = _currentDevice;
+  request.name = currentDevice();
+  request.protocol = _protocolsComboBox->currentText().toStdString();
+  request.localHost = _localHostBox->text().toStdString();
+  request.destinationPort = _portOutputBox->value();
+  request.receptionPort = _portInputBox->value();
+  request.namespaceFilePath = _namespaceFilePath->text().toStdString();
+
+  if (_newDevice || _nameChanged) {
+      _currentDevice = QString::fromStdString(request.name);
+    }
+
+  _newDevice = false;
+  _changed = false;
+  _nameChanged = false;
+  _protocolChanged = false;
+  _localHostChanged = false;
+  _networkPortChanged = false;
+  _namespacePathChanged = false;
+
+  emit updateRequested(request, createRequestTimer());
+}
+
+void
+DeviceEdit::rebuildNamespace(QString deviceName, bool updateBoxes, bool background)
+{
+  emit rebuildRequested(deviceName, updateBoxes, background, createRequestTimer());
+}
+
+unsigned int
+DeviceEdit::createRequestTimer()
+{
+  unsigned int requestId = ++_lastRequestId;
+  QTimer *timer = new QTimer(this);
+
+  // the timer is started when the updater begins the request : the requests queued before don't count
+  timer->setSingleShot(true);
+  connect(timer, &QTimer::timeout, this, [this, requestId] () { requestTimedOut(requestId); });
+
+  _requestTimers.insert(requestId, timer);
+
+  return requestId;
+}
+
+void
+DeviceEdit::requestStarted(unsigned int requestId)
+{
+  QTimer *timer = _requestTimers.value(requestId);
+  if (timer != nullptr) {
+      timer->start(REQUEST_TIMEOUT);
+    }
+}
+
+void
+DeviceEdit::requestFinished(unsigned int requestId)
+{
+  QTimer *timer = _requestTimers.take(requestId);
+  if (timer != nullptr) {
+      timer->stop();
+      timer->deleteLater();
+    }
+}
+
+void
+DeviceEdit::requestTimedOut(unsigned int requestId)
+{
+  // drop the results of the request and enable the tree again (the device can still answer in background)
+  updater.cancel(requestId);
+  requestFinished(requestId);
+  emit progress(tr("A device doesn't answer"));
+}
+
 void
 DeviceEdit::openFileDialog()
 {
@@ -756,10 +756,15 @@ MainWindow::saveFile(const QString &fileName)
 
   QApplication::setOverrideCursor(Qt::WaitCursor);
 
-  _scene->save(fileName.toStdString());
+  bool saved = _scene->save(fileName.toStdString());
 
   QApplication::restoreOverrideCursor();
 
+  if (!saved) {
+      QMessageBox::warning(this, "", tr("A device is refreshing its namespace : save again once it is done."));
+      return false;
+    }
+
   setCurrentFile(fileName);
   statusBar()->showMessage(tr("File saved"), 2000);
   return true;
@@ -151,16 +151,33 @@ MaquetteScene::init()
 void
 MaquetteScene::updateProgressBar()
 {
-  if (_maquette->isExecutionOn()) {      
-      _progressLine->setPos(_maquette->getCurrentTime() / MS_PER_PIXEL, sceneRect().topLeft().y());
-      invalidate();
+  updateProgressBar(_maquette->getExecutionState());
+}
+
+void
+MaquetteScene::updateProgressBar(const ExecutionState &state)
+{
+  // the line item repaints only its previous and its new strip when it moves
+  if (state.running) {
+      _progressLine->setPos(state.date / MS_PER_PIXEL, sceneRect().topLeft().y());
     }
   else {      
       _progressLine->setPos(_maquette->getTimeOffset() / MS_PER_PIXEL, sceneRect().topLeft().y());
-      invalidate();
     }
 }
 
+bool
+MaquetteScene::isDisplayed() const
+{
+  for (QGraphicsView *view : views()) {
+      if (view->isVisible() && !view->window()->isMinimized()) {
+          return true;
+        }
+    }
+
+  return false;
+}
+
 void
 MaquetteScene::zoomChanged(float value)
 {
@@ -242,6 +259,18 @@ MaquetteScene::getPosition(unsigned int boxID)
   return _maquette->getPosition(boxID);
 }
 
+const ExecutionState &
+MaquetteScene::getExecutionState()
+{
+  return _maquette->getExecutionState();
+}
+
+void
+MaquetteScene::processExecutionEvents()
+{
+  _maquette->processExecutionEvents();
+}
+
 unsigned int
 MaquetteScene::getTimeOffset()
 {
@@ -1505,6 +1534,8 @@ MaquetteScene::boxResized()
 void
 MaquetteScene::selectionMoved()
 {
+  map<unsigned int, Coords> boxes;
+
   for(auto& curItem : selectedItems())
   {
     switch(curItem->type())
@@ -1512,7 +1543,9 @@ MaquetteScene::selectionMoved()
       case PARENT_BOX_TYPE:
        {
          ParentBox *curBox = static_cast<ParentBox*>(curItem);
-         boxMoved(curBox->ID());
+         Coords coord;
+         if (boxCoords(curBox->ID(), coord))
+           boxes[curBox->ID()] = coord;
          break;
        }
 
@@ -1521,28 +1554,43 @@ MaquetteScene::selectionMoved()
         break;
     }
   }
+
+  // move all the selected boxes in one edition
+  if (!boxes.empty() && _maquette->updateBoxes(boxes)) {
+      update();
+      setModified(true);
+    }
 }
 
 bool
-MaquetteScene::boxMoved(unsigned int boxID)
+MaquetteScene::boxCoords(unsigned int boxID, Coords &coord)
 {
-//  std::cout<<"--- boxMoved ---"<<boxID<<std::endl;
-  Coords coord;
   BasicBox * box = _maquette->getBox(boxID);
-  if (box != nullptr) {
+  if (box == nullptr) {
+      return false;
+    }
 
-      if (!box->hasMother()) {
-          coord.topLeftX = box->mapToScene(box->boxRect().topLeft()).x();
-        }
-      else {
-          coord.topLeftX = box->mapToScene(box->boxRect().topLeft()).x()
-                           - getBox(box->mother())->beginPos();
-        }
-      coord.topLeftY = box->mapToScene(box->boxRect().topLeft()).y();
-      coord.sizeX = box->boxRect().size().width();
-//      std::cout<<"Y = "<<coord.sizeX* MaquetteScene::MS_PER_PIXEL<<std::endl;
-      coord.sizeY = box->boxRect().size().height();
+  if (!box->hasMother()) {
+      coord.topLeftX = box->mapToScene(box->boxRect().topLeft()).x();
     }
+  else {
+      coord.topLeftX = box->mapToScene(box->boxRect().topLeft()).x()
+                       - getBox(box->mother())->beginPos();
+    }
+  coord.topLeftY = box->mapToScene(box->boxRect().topLeft()).y();
+  coord.sizeX = box->boxRect().size().width();
+//      std::cout<<"Y = "<<coord.sizeX* MaquetteScene::MS_PER_PIXEL<<std::endl;
+  coord.sizeY = box->boxRect().size().height();
+
+  return true;
+}
+
+bool
+MaquetteScene::boxMoved(unsigned int boxID)
+{
+//  std::cout<<"--- boxMoved ---"<<boxID<<std::endl;
+  Coords coord;
+  boxCoords(boxID, coord);
 
   bool ret = _maquette->updateBox(boxID, coord);
 
@@ -1687,12 +1735,13 @@ MaquetteScene::setPlaying(unsigned int boxID, bool playing)
 }
 
 void
-MaquetteScene::updatePlayingBoxes()
+MaquetteScene::updatePlayingBoxes(const ExecutionState &state)
 {    
   map<unsigned int, BasicBox*>::iterator it;
 
   for (it = _playingBoxes.begin(); it != _playingBoxes.end(); ++it) {
-      it->second->update();
+      std::map<TimeBoxId, float>::const_iterator position = state.positions.find(it->first);
+      it->second->updateProgressBar(position != state.positions.end() ? position->second : 0.);
 
       //Recording curves
 //      if(it->second->recording()){
@@ -1748,6 +1797,15 @@ MaquetteScene::stopOrPause()
     }        
 }
 
+void
+MaquetteScene::pauseOrResume()
+{
+    if (paused())
+        playOrResume();
+    else if (playing())
+        stopOrPause();
+}
+
 void
 MaquetteScene::stopOrPause(QList<unsigned int> boxesId)
 {
@@ -1973,11 +2031,13 @@ MaquetteScene::setModified(bool modified)
   _modified = modified;
 }
 
-void
+bool
 MaquetteScene::save(const string &fileName)
 {
-  _maquette->save(fileName);
+  if (!_maquette->save(fileName))
+    return false;
   setModified(false);
+  return true;
 }
 
 void
@@ -43,6 +43,8 @@
 #include "Maquette.hpp"
 #include "MainWindow.hpp"
 #include <QList>
+#include <QHash>
+#include <unordered_set>
 #include <map>
 #include <vector>
 #include <string>
@@ -50,6 +52,8 @@
 #include <QTreeView>
 #include <QByteArray>
 #include <QMessageBox>
+#include <QStatusBar>
+#include <QMainWindow>
 #include <QAbstractItemModel>
 #include <QAbstractItemView>
 #include <QTreeView>
@@ -313,6 +317,7 @@ NetworkTree::NetworkTree(QWidget *parent) : QTreeWidget(parent)
   hideColumn(VALUE_COLUMN);  
   
   connect(this, SIGNAL(itemClicked(QTreeWidgetItem *, int)), this, SLOT(clickInNetworkTree(QTreeWidgetItem *, int)));
+  connect(this, SIGNAL(itemExpanded(QTreeWidgetItem *)), this, SLOT(exploreExpandedItem(QTreeWidgetItem *)));
   connect(this, SIGNAL(itemChanged(QTreeWidgetItem*, int)), this, SLOT(valueChanged(QTreeWidgetItem*, int)));
   connect(this, SIGNAL(startValueChanged(QTreeWidgetItem*, QString)), this, SLOT(changeStartValue(QTreeWidgetItem*, QString)));
   connect(this, SIGNAL(endValueChanged(QTreeWidgetItem*, QString)), this, SLOT(changeEndValue(QTreeWidgetItem*, QString)));
@@ -332,6 +337,17 @@ NetworkTree::NetworkTree(QWidget *parent) : QTreeWidget(parent)
 		  this,		   &NetworkTree::disable, Qt::DirectConnection);
   connect(_deviceEdit, &DeviceEdit::enableTree,
 		  this,		   &NetworkTree::enable, Qt::DirectConnection);
+  connect(_deviceEdit, &DeviceEdit::namespaceRebuilt,
+		  this,		   &NetworkTree::finishItemNamespaceRefresh, Qt::DirectConnection);
+  connect(_deviceEdit, &DeviceEdit::namespaceRebuildFailed,
+		  this,		   &NetworkTree::abortItemNamespaceRefresh, Qt::DirectConnection);
+  connect(_deviceEdit, &DeviceEdit::progress,
+		  this,		   [this] (QString step)
+  {
+      QMainWindow *mainWindow = qobject_cast<QMainWindow *>(window());
+      if(mainWindow)
+          mainWindow->statusBar()->showMessage(step, 2000);
+  });
 
   connect(this,        &NetworkTree::deviceUpdated,
           this,        &NetworkTree::refreshItemNamespace);
@@ -420,6 +436,7 @@ NetworkTree::clear()
   QList<QTreeWidgetItem*>::iterator it;
 
   _addressMap.clear();
+  _itemsMap.clear();
   _nodesWithSelectedChildren.clear();
   _assignedItems.clear();
   _nodesWithSomeChildrenAssigned.clear();
@@ -463,7 +480,7 @@ NetworkTree::load()
       QTreeWidgetItem *curItem = new QTreeWidgetItem(DeviceNode);
       curItem->setText(NAME_COLUMN , deviceName);
       curItem->setCheckState(NAME_COLUMN,Qt::Unchecked);
-      treeRecursiveExploration(curItem, true);
+      exploreItem(curItem);
       itemsList << curItem;
 
       Maquette::getInstance()->getDeviceProtocol(deviceName.toStdString(),protocol);
@@ -516,6 +533,12 @@ NetworkTree:: getItemsFromMsg(vector<string> itemsName)
               msg.message += curName.section('/', 1, nbSection);
             }
 
+          QTreeWidgetItem *itemFound = getItemFromAddress(address.first().toStdString());
+          if (itemFound != nullptr) {
+              itemsMatchedList << qMakePair(itemFound, msg);
+              continue;
+            }
+
           itemsFound = this->findItems(splitAddress.last(), Qt::MatchRecursive, 0);
           if (itemsFound.size() > 1) {
               QList<QTreeWidgetItem *>::iterator it3;
@@ -725,54 +748,35 @@ NetworkTree::getDeviceName(QTreeWidgetItem *item) const
 }
 
 QTreeWidgetItem *
-NetworkTree::getItemFromAddress(string address) const
+NetworkTree::getItemFromAddress(string address)
 {
-  return _addressMap.key(address);
+  auto it = _itemsMap.find(address);
+  if (it != _itemsMap.end()) {
+      return it->second;
+    }
+
+  // the item may not be created yet : explore the items along the address
+  size_t pos = address.find('/');
+  while (pos != string::npos) {
+      auto parent = _itemsMap.find(address.substr(0, pos));
+      if (parent == _itemsMap.end()) {
+          return nullptr;
+        }
+      if (hasPlaceholder(parent->second)) {
+          exploreItem(parent->second);
+        }
+      pos = address.find('/', pos + 1);
+    }
+
+  it = _itemsMap.find(address);
+
+  return it != _itemsMap.end() ? it->second : nullptr;
 }
 
 QPair< QMap <QTreeWidgetItem *, Data>, QList<QString> >
 NetworkTree::treeSnapshot(unsigned int boxID)
 {
-  Q_UNUSED(boxID);
-
-  QMap<QTreeWidgetItem *, Data> snapshots;
-  QList<QString> devicesConcerned;
-
-  QList<QTreeWidgetItem*> selection = assignedItems().keys();
-  if (!selection.empty()) {
-      QList<QTreeWidgetItem*>::iterator it;
-      vector<string>::iterator it2;
-      QTreeWidgetItem *curItem;
-      for (it = selection.begin(); it != selection.end(); ++it) {
-          curItem = *it;
-          if (curItem->type() != DeviceNode && curItem->type() != NodeNoNamespaceType){
-              QString address = getAbsoluteAddress(*it);
-
-              //get device concerned
-              QString deviceName = getDeviceName(*it);
-              if (!devicesConcerned.contains(deviceName)) {
-                  devicesConcerned.append(deviceName);
-                }
-
-              QPair<QTreeWidgetItem *, Data> curPair;
-
-              if (!address.isEmpty()) {                  
-                  vector<string> snapshot = Maquette::getInstance()->requestNetworkSnapShot(address.toStdString());
-
-                  Data data;
-                  for (it2 = snapshot.begin(); it2 != snapshot.end(); it2++) {
-                      data.msg = QString::fromStdString(*it2);
-                      data.address = address;
-//                        data.sampleRate = Maquette::getInstance()->getCurveSampleRate(boxID,address.toStdString());
-                      data.hasCurve = false;
-                      snapshots.insert(*it, data);
-                    }
-                }
-            }
-        }
-    }
-
-  return qMakePair(snapshots, devicesConcerned);
+  return treeSnapshot(boxID, assignedItems().keys());
 }
 
 QPair< QMap <QTreeWidgetItem *, Data>, QList<QString> >
@@ -782,11 +786,14 @@ NetworkTree::treeSnapshot(unsigned int boxID, QList<QTreeWidgetItem *> itemsList
 
   QMap<QTreeWidgetItem *, Data> snapshots;
   QList<QString> devicesConcerned;
+  QMultiHash<AddressId, QTreeWidgetItem *> itemsByAddress;
+  QHash<QTreeWidgetItem *, QString> addresses;
+  vector<AddressId> addressesToSnap;
+  AddressTable &table = AddressTable::getInstance();
 
   QList<QTreeWidgetItem*> selection = itemsList;
   if (!selection.empty()) {
       QList<QTreeWidgetItem*>::iterator it;
-      vector<string>::iterator it2;
       QTreeWidgetItem *curItem;
       for (it = selection.begin(); it != selection.end(); ++it) {
           curItem = *it;
@@ -799,24 +806,40 @@ NetworkTree::treeSnapshot(unsigned int boxID, QList<QTreeWidgetItem *> itemsList
                   devicesConcerned.append(deviceName);
                 }
 
-              QPair<QTreeWidgetItem *, Data> curPair;
-
               if (!address.isEmpty()) {
-                  vector<string> snapshot = Maquette::getInstance()->requestNetworkSnapShot(address.toStdString());
-
-                  Data data;
-                  for (it2 = snapshot.begin(); it2 != snapshot.end(); it2++) {
-                      data.msg = QString::fromStdString(*it2);
-                      data.address = address;
-//                        data.sampleRate = Maquette::getInstance()->getCurveSampleRate(boxID,address.toStdString());
-                      data.hasCurve = false;
-                      snapshots.insert(*it, data);
+                  AddressId id = table.intern(address.toStdString());
+
+                  if (!itemsByAddress.contains(id)) {
+                      addressesToSnap.push_back(id);
                     }
+                  itemsByAddress.insert(id, *it);
+                  addresses.insert(*it, address);
                 }
             }
         }
     }
 
+  // snap all the addresses in one pass then dispatch the values to the items
+  StateLines snapshot;
+  Maquette::getInstance()->requestNetworkSnapShot(addressesToSnap, snapshot);
+
+  StateLines::iterator lineIt;
+  for (lineIt = snapshot.begin(); lineIt != snapshot.end(); ++lineIt) {
+      lineIt->value.toString();
+      QString value = QString::fromStdString(TTString(lineIt->value[0]).c_str());
+
+      QList<QTreeWidgetItem *> items = itemsByAddress.values(lineIt->address);
+      QList<QTreeWidgetItem *>::iterator itemIt;
+      for (itemIt = items.begin(); itemIt != items.end(); ++itemIt) {
+          Data data;
+          data.address = addresses.value(*itemIt);
+          data.msg = data.address + " " + value;
+//          data.sampleRate = Maquette::getInstance()->getCurveSampleRate(boxID,address.toStdString());
+          data.hasCurve = false;
+          snapshots.insert(*itemIt, data);
+        }
+    }
+
   return qMakePair(snapshots, devicesConcerned);
 }
 
@@ -841,71 +864,199 @@ NetworkTree::hasEndMsg(QTreeWidgetItem *item){
 ****************************************************************************/
 
 void
-NetworkTree::treeRecursiveExploration(QTreeWidgetItem *curItem, bool conflict)
+NetworkTree::exploreItem(QTreeWidgetItem *curItem, bool recursive)
 {
     if (!curItem->isDisabled()) {
 
-         vector<string>            children;
-         string                    nodeType,
-                                   address = (getAbsoluteAddress(curItem)).toStdString();
+         NamespaceNodes            dump;
+         string                    address = (getAbsoluteAddress(curItem)).toStdString();
 
-         //TOTO : check if necessary (unused for the moment) NH.
-         // A tester plus en avant
-         auto preexistingkeys = _addressMap.keys(address);
-         for(auto& key : preexistingkeys) _addressMap.remove(key);
+         indexAddress(curItem, address);
 
-         _addressMap.insert(curItem, address);
-
-         //Get object's children
-         if(Maquette::getInstance()->getObjectChildren(address,children) > 0)
+         // Get the whole branch (or the children only) with the attributes of each node in one call
+         // (the placeholder stays while the namespace of the device is being rebuilt : the item can be explored again later)
+         if(Maquette::getInstance()->requestNetworkNamespaceDump(address, dump, recursive) > 0)
          {
-             for(const auto& child : children)
+             if (hasPlaceholder(curItem))
+                 delete curItem->takeChild(0);
+
+             // the nodes come before their children : the parent of a node is already created (or filtered)
+             std::unordered_map<string, QTreeWidgetItem *> parents{{address, curItem}};
+
+             for(const auto& node : dump)
              {
-                 QStringList name{QString::fromStdString(child)};
-                 NetworkTreeItem *childItem{};
-                 string childAbsoluteAddress = address;
-                 childAbsoluteAddress.append("/");
-                 childAbsoluteAddress.append(child);
-
-                 if(Maquette::getInstance()->getObjectType(childAbsoluteAddress,nodeType) && nodeType == "Data")
-                 {
-                     childItem = new NetworkTreeItem(curItem, name, LeaveType);
-                     childItem->setupProperties(LeafProperties());
-                 }
-                 else
-                 {
-                     childItem = new NetworkTreeItem(curItem, name, NodeNoNamespaceType);
-                     childItem->setupProperties(NodeProperties());
-                 }
-
-                 treeRecursiveExploration(childItem, conflict);
-                 setNewItemProperties(childItem);
+                 auto parent = parents.find(node.address.substr(0, node.address.rfind('/')));
+                 if(parent == parents.end())
+                     continue;
+
+                 QTreeWidgetItem *childItem = createChildItem(parent->second, node, recursive);
+                 if(recursive && childItem != nullptr && childItem->type() != LeaveType)
+                     parents[node.address] = childItem;
              }
          }
      }
 }
 
-void NetworkTree::setNewItemProperties(NetworkTreeItem* curItem)
+QTreeWidgetItem *
+NetworkTree::createChildItem(QTreeWidgetItem *curItem, const NamespaceNode &node, bool explored)
 {
-    // Get the required properties from Maquette
-    auto address = (getAbsoluteAddress(curItem)).toStdString();
+    QStringList name{QString::fromStdString(node.address.substr(node.address.rfind('/') + 1))};
+    NetworkTreeItem *childItem{};
+
+    if(node.type == "Data")
+    {
+        childItem = new NetworkTreeItem(curItem, name, LeaveType);
+        childItem->setupProperties(LeafProperties());
+    }
+    else
+    {
+        childItem = new NetworkTreeItem(curItem, name, NodeNoNamespaceType);
+        childItem->setupProperties(NodeProperties());
+    }
+
+    // the item could have been filtered
+    if(!setNewItemProperties(childItem, node))
+        return nullptr;
+
+    indexAddress(childItem, node.address);
+
+    // the children of the nodes are explored when expanded
+    if(!explored && childItem->type() != LeaveType)
+        addPlaceholder(childItem);
+
+    return childItem;
+}
+
+void
+NetworkTree::mergeItemChildren(QTreeWidgetItem *curItem)
+{
+    // the items which were never explored will be created from the new namespace when expanded
+    if(hasPlaceholder(curItem))
+        return;
+
+    NamespaceNodes dump;
+    string address = getAbsoluteAddress(curItem).toStdString();
+
+    Maquette::getInstance()->requestNetworkNamespaceDump(address, dump, false);
+
+    std::unordered_map<string, const NamespaceNode *> newChildren;
+    for(const auto& node : dump)
+        newChildren[node.address] = &node;
+
+    std::unordered_set<string> keptChildren;
+
+    // remove the items which disappeared or changed from node to leaf (and vice versa)
+    for(int i = curItem->childCount() - 1; i >= 0; i--)
+    {
+        QTreeWidgetItem *childItem = curItem->child(i);
+        if(childItem->type() != LeaveType && childItem->type() != NodeNoNamespaceType)
+            continue;
 
-    std::vector<std::string> tagsValues;
-    auto tagsResult = Maquette::getInstance()->requestObjectAttribruteValue(address,"tags",tagsValues);
+        string childAddress = address + "/" + childItem->text(NAME_COLUMN).toStdString();
+        auto node = newChildren.find(childAddress);
 
-    std::vector<std::string> servicesValues;
-    auto servicesResult = Maquette::getInstance()->requestObjectAttribruteValue(address,"service",servicesValues);
+        if(node != newChildren.end() && (node->second->type == "Data") == (childItem->type() == LeaveType))
+        {
+            keptChildren.insert(childAddress);
+            if(childItem->type() != LeaveType)
+                mergeItemChildren(childItem);
+        }
+        else
+        {
+            unindexItems(childItem);
+            delete curItem->takeChild(i);
+        }
+    }
 
-    std::string nodeType;
-    Maquette::getInstance()->getObjectType(address,nodeType);
+    // create the new ones
+    for(const auto& node : dump)
+    {
+        if(!keptChildren.count(node.address))
+            createChildItem(curItem, node);
+    }
+}
 
+void
+NetworkTree::addPlaceholder(QTreeWidgetItem *item)
+{
+  QTreeWidgetItem *placeholder = new QTreeWidgetItem(QStringList("..."), PlaceholderType);
+  placeholder->setFlags(Qt::NoItemFlags);
+  item->addChild(placeholder);
+}
 
+bool
+NetworkTree::hasPlaceholder(QTreeWidgetItem *item) const
+{
+  return item->childCount() == 1 && item->child(0)->type() == PlaceholderType;
+}
+
+void
+NetworkTree::exploreExpandedItem(QTreeWidgetItem *item)
+{
+  if (hasPlaceholder(item)) {
+      exploreItem(item);
+    }
+}
+
+void
+NetworkTree::indexAddress(QTreeWidgetItem *item, const string &address)
+{
+  // an address is shown by only one item
+  auto previousItem = _itemsMap.find(address);
+  if (previousItem != _itemsMap.end() && previousItem->second != item) {
+      _addressMap.remove(previousItem->second);
+    }
+
+  // the item could have been indexed at another address before a rename
+  auto previousAddress = _addressMap.find(item);
+  if (previousAddress != _addressMap.end() && previousAddress.value() != address) {
+      _itemsMap.erase(previousAddress.value());
+    }
+
+  _addressMap.insert(item, address);
+  _itemsMap[address] = item;
+}
+
+void
+NetworkTree::unindexItems(QTreeWidgetItem *item, bool withItem)
+{
+  if (withItem) {
+      auto address = _addressMap.find(item);
+      if (address != _addressMap.end()) {
+          auto indexedItem = _itemsMap.find(address.value());
+          if (indexedItem != _itemsMap.end() && indexedItem->second == item) {
+              _itemsMap.erase(indexedItem);
+            }
+          _addressMap.erase(address);
+        }
+    }
+
+  for (int i = 0; i < item->childCount(); i++) {
+      unindexItems(item->child(i));
+    }
+}
+
+void
+NetworkTree::reindexItems(QTreeWidgetItem *item)
+{
+  if (_addressMap.contains(item)) {
+      indexAddress(item, getAbsoluteAddress(item).toStdString());
+    }
+
+  for (int i = 0; i < item->childCount(); i++) {
+      reindexItems(item->child(i));
+    }
+}
+
+bool NetworkTree::setNewItemProperties(NetworkTreeItem* curItem, const NamespaceNode& node)
+{
+    // The required properties come with the node (an attribute is empty when the object doesn't have it)
+    const std::string& nodeType = node.type;
 
     //Gets priority
-    unsigned int priority = 0;
-    if(!Maquette::getInstance()->getPriority(address,priority))
+    if(!node.priority.empty())
     {
-        curItem->setText(PRIORITY_COLUMN,QString("%1").arg(priority));
+        curItem->setText(PRIORITY_COLUMN,QString::fromStdString(node.priority));
     }
 
     // Filtering
@@ -916,61 +1067,61 @@ void NetworkTree::setNewItemProperties(NetworkTreeItem* curItem)
                             nodeType == "Input.audio" ||
                             nodeType == "Output.audio" ||
                             nodeType == "Viewer")
-                        || (tagsResult > 0 && !tagsValues.empty() && tagsValues[0] == "setup")
-                        || (servicesResult > 0 && nodeType == "Container" && !servicesValues.empty() && servicesValues[0] == "view" );
+                        || node.tags == "setup"
+                        || (nodeType == "Container" && node.service == "view");
 
         if(toDelete)
         {
+            unindexItems(curItem);
             delete curItem;
-            return;
+            return false;
         }
 
         if(nodeType == "PresetManager")
         {
             curItem->setupProperties(PresetManagerProperties());
-            return;
+            return true;
         }
     }
 
-    if(servicesResult > 0 && nodeType != "Container")
+    if(!node.service.empty() && nodeType != "Container")
     {
         curItem->setCheckState(INTERPOLATION_COLUMN, Qt::Unchecked);
         curItem->setCheckState(REDUNDANCY_COLUMN, Qt::Unchecked);
         curItem->setCheckState(START_ASSIGNATION_COLUMN, Qt::Unchecked);
         curItem->setCheckState(END_ASSIGNATION_COLUMN, Qt::Unchecked);
 
-        if(!servicesValues.empty())
+        if(node.service == "return")
         {
-            if(servicesValues[0] == "return")
-            {
-                curItem->setupProperties(ReturnProperties());
-                return;
-            }
+            curItem->setupProperties(ReturnProperties());
+            return true;
+        }
 
-            if(servicesValues[0] == "message")
-            {
-                curItem->setupProperties(MessageProperties());
-                return;
-            }
+        if(node.service == "message")
+        {
+            curItem->setupProperties(MessageProperties());
+            return true;
+        }
 
-            if(servicesValues[0] == "parameter")
-            {
-                curItem->setupProperties(ParameterProperties());
-            }
+        if(node.service == "parameter")
+        {
+            curItem->setupProperties(ParameterProperties());
         }
 
         curItem->setFlags(Qt::ItemIsSelectable | Qt::ItemIsEnabled | Qt::ItemIsDragEnabled | Qt::ItemIsUserCheckable);
     }
 
     //Get range bounds
-    vector<float> rangeBounds;
-    if(Maquette::getInstance()->getRangeBounds(address,rangeBounds)>0)
+    QStringList rangeBounds = QString::fromStdString(node.range).split(" ");
+    if(rangeBounds.size() == 2)
     {
-        curItem->setText(MIN_COLUMN,QString("%1").arg(rangeBounds[0]));
+        curItem->setText(MIN_COLUMN,QString("%1").arg(rangeBounds[0].toFloat()));
         curItem->setToolTip(MIN_COLUMN, curItem->text(MIN_COLUMN));
-        curItem->setText(MAX_COLUMN,QString("%1").arg(rangeBounds[1]));
+        curItem->setText(MAX_COLUMN,QString("%1").arg(rangeBounds[1].toFloat()));
         curItem->setToolTip(MAX_COLUMN, curItem->text(MAX_COLUMN));
     }
+
+    return true;
 }
 
 void
@@ -1150,6 +1301,7 @@ void NetworkTree::removeCurrentNode()
         switch (ret) {
             case QMessageBox::Yes:{
                 removeOSCMessage(currentItem());
+                unindexItems(currentItem());
                 currentItem()->parent()->removeChild(currentItem());
                 break;
             }
@@ -1580,82 +1732,109 @@ QList<QTreeWidgetItem*> NetworkTree::getExpandedItems()
 void
 NetworkTree::refreshItemNamespace(QTreeWidgetItem *item, bool updateBoxes)
 {
-    bool isLearning{isInLearningMode()};
+    if(item == nullptr || item->type() != DeviceNode)
+        return;
+
+    NamespaceRefresh refresh;
+    refresh.learning = isInLearningMode();
+
     // Make a copy of the addresses which were expanded
-    std::vector<std::string> previouslyExpandedAddresses;
     applyInTree(invisibleRootItem(), [&] (QTreeWidgetItem* it)
     {
         if(it->isExpanded())
         {
-            previouslyExpandedAddresses.push_back(getAbsoluteAddress(it).toStdString());
+            refresh.expandedAddresses.push_back(getAbsoluteAddress(it).toStdString());
         }
     });
 
     // Make a copy of all the addresses
-    std::vector<std::string> previousAddressMap;
-    if(isLearning)
+    if(refresh.learning)
     {
-        for(auto& addr : _addressMap)
+        refresh.previousAddresses.reserve(_itemsMap.size());
+        for(auto& addr : _itemsMap)
         {
-            previousAddressMap.push_back(addr);
+            refresh.previousAddresses.insert(addr.first);
         }
     }
 
-    if(item != nullptr)
+    string application = getAbsoluteAddress(item).toStdString();
+
+    // the namespace is rebuilt by the updater thread then the items are replaced by finishItemNamespaceRefresh
+    _pendingRefreshes[application] = refresh;
+    _deviceEdit->rebuildNamespace(QString::fromStdString(application), updateBoxes);
+}
+
+void
+NetworkTree::finishItemNamespaceRefresh(QString deviceName, bool updateBoxes)
+{
+    auto pending = _pendingRefreshes.find(deviceName.toStdString());
+    if(pending == _pendingRefreshes.end())
+        return;
+
+    NamespaceRefresh refresh = pending->second;
+    _pendingRefreshes.erase(pending);
+
+    // the device could have been removed meanwhile
+    QTreeWidgetItem *item = getItemFromAddress(deviceName.toStdString());
+    if(item == nullptr)
+        return;
+
+    if(refresh.revalidation)
     {
-        if(item->type() == DeviceNode)
-        {
-            collapseItem(item);
-            string application = getAbsoluteAddress(item).toStdString();
-            item->takeChildren();
+        // nothing to do if the device didn't change since its namespace cache was stored
+        if(Maquette::getInstance()->isNetworkNamespaceCacheValid(deviceName.toStdString()))
+            return;
 
-            /// \todo récupérer la valeur de retour.
-            /// Peut être false en cas de OSC (traitement différent dans ce cas là).
-            Maquette::getInstance()->rebuildNetworkNamespace(application);
-            treeRecursiveExploration(item, true);
-            if(updateBoxes)
-                Maquette::getInstance()->updateBoxesAttributes();
+        Maquette::getInstance()->storeNetworkNamespaceCache(deviceName.toStdString());
+        mergeItemChildren(item);
+    }
+    else
+    {
+        collapseItem(item);
+        unindexItems(item, false);
+        item->takeChildren();
 
-            if(isOSC(item))
-                createOSCBranch(item);
-        }
+        // in learning mode all the items are created to expand the new ones
+        exploreItem(item, refresh.learning);
     }
 
+    if(updateBoxes)
+        Maquette::getInstance()->updateBoxesAttributes();
+
+    if(isOSC(item))
+        createOSCBranch(item);
+
     // Restore the addresses
     QList<QTreeWidgetItem*> itemsToExpand;
 
     // The ones that were expanded
-    for(auto& addr : previouslyExpandedAddresses)
+    for(auto& addr : refresh.expandedAddresses)
     {
-        if(std::find(_addressMap.begin(),
-                     _addressMap.end(),
-                     addr) != _addressMap.end())
-        {
-            const auto& tree_items = _addressMap.keys(addr);
-            for(auto& item : tree_items)
-                itemsToExpand.append(item);
-        }
+        auto tree_item = getItemFromAddress(addr);
+        if(tree_item != nullptr)
+            itemsToExpand.append(tree_item);
     }
 
     // The new ones
-    if(isLearning)
+    if(refresh.learning)
     {
-        for(auto& addr : _addressMap)
+        for(auto& addr : _itemsMap)
         {
-            if(std::find(previousAddressMap.begin(),
-                         previousAddressMap.end(),
-                         addr) == previousAddressMap.end())
-            {
-                const auto& tree_items = _addressMap.keys(addr);
-                for(auto& item : tree_items)
-                    itemsToExpand.append(item);
-            }
+            if(refresh.previousAddresses.find(addr.first) == refresh.previousAddresses.end())
+                itemsToExpand.append(addr.second);
         }
     }
 
     expandItems(itemsToExpand);
 }
 
+void
+NetworkTree::abortItemNamespaceRefresh(QString deviceName)
+{
+    // the items are only replaced once the rebuild succeeded : the previous ones are kept
+    _pendingRefreshes.erase(deviceName.toStdString());
+}
+
 void
 NetworkTree::refreshCurrentItemNamespace()
 {
@@ -1663,18 +1842,63 @@ NetworkTree::refreshCurrentItemNamespace()
         refreshItemNamespace(currentItem());
 }
 
+void
+NetworkTree::refreshAllNamespaces()
+{
+    // the devices are rebuilt concurrently and each one is updated in the tree as soon as it is done
+    for(int i = 0; i < topLevelItemCount(); i++)
+    {
+        if(topLevelItem(i)->type() == DeviceNode)
+            refreshItemNamespace(topLevelItem(i));
+    }
+}
+
+void
+NetworkTree::revalidateNamespaces()
+{
+    for(int i = 0; i < topLevelItemCount(); i++)
+    {
+        QTreeWidgetItem *item = topLevelItem(i);
+        std::string protocol;
+
+        if(item->type() != DeviceNode)
+            continue;
+
+        Maquette::getInstance()->getDeviceProtocol(item->text(NAME_COLUMN).toStdString(), protocol);
+        if(protocol != "Minuit")
+            continue;
+
+        // the items stay usable while the device is rebuilt in background (the tree isn't disabled)
+        NamespaceRefresh refresh;
+        refresh.revalidation = true;
+
+        string application = getAbsoluteAddress(item).toStdString();
+        _pendingRefreshes[application] = refresh;
+        _deviceEdit->rebuildNamespace(QString::fromStdString(application), true, true);
+    }
+}
+
 void
 NetworkTree::deleteCurrentItemNamespace()
 {
     if(currentItem() != nullptr){
         QString itemName = getAbsoluteAddress(currentItem());
 
+        // the device can't be released while it answers a rebuild
+        if(_pendingRefreshes.count(itemName.toStdString()))
+        {
+            QMessageBox::warning(this, QString("Delete %1").arg(itemName),
+                                 QString("%1 is refreshing its namespace : delete it once it is done.").arg(itemName));
+            return;
+        }
+
         int ret = QMessageBox::warning(this, QString("Delete %1").arg(itemName),
                                         QString("Do you really want to delete %1 ?").arg(itemName),
                                         QMessageBox::Yes | QMessageBox::Cancel,
                                         QMessageBox::Cancel);
         switch (ret) {
         case QMessageBox::Yes:{
+            unindexItems(currentItem());
             delete currentItem();
             Maquette::getInstance()->removeNetworkDevice(itemName.toStdString());
             return;
@@ -1884,17 +2108,21 @@ NetworkTree::mousePressEvent(QMouseEvent *event)
                 {
                     QMenu *contextMenu = new QMenu(this);
                     QAction *refreshAct = new QAction(tr("Refresh"),this);
+                    QAction *refreshAllAct = new QAction(tr("Refresh all devices"),this);
                     QAction *deleteAct = new QAction(tr("Delete"),this);
 
                     contextMenu->addAction(refreshAct);
+                    contextMenu->addAction(refreshAllAct);
                     contextMenu->addAction(deleteAct);
 
                     connect(refreshAct, SIGNAL(triggered()), this, SLOT(refreshCurrentItemNamespace()));
+                    connect(refreshAllAct, SIGNAL(triggered()), this, SLOT(refreshAllNamespaces()));
                     connect(deleteAct, SIGNAL(triggered()), this, SLOT(deleteCurrentItemNamespace()));
 
                     contextMenu->exec(event->globalPos());
 
                     refreshAct->deleteLater();
+                    refreshAllAct->deleteLater();
                     deleteAct->deleteLater();
                     contextMenu->deleteLater();
                     break;
@@ -2230,14 +2458,18 @@ NetworkTree::getAbsoluteAddressWithValue(QTreeWidgetItem *item, int column) cons
 QList<string> NetworkTree::getAddressList()
 {
     QList<string> addressList;
-    QMap<QTreeWidgetItem *, string>::iterator it;
+    QHash<QTreeWidgetItem *, string>::iterator it;
+
+    // the whole namespace is listed : explore the items which were not expanded yet
+    QList<QTreeWidgetItem *> items;
+    for (int i = 0; i < topLevelItemCount(); i++) {
+        getChildren(topLevelItem(i), items);
+    }
+
     for (it = _addressMap.begin(); it != _addressMap.end(); it++) {
         if(it.key() != nullptr) {
-            QTreeWidgetItem* item = it.key();
-            if(checkPredicateInTree(this->invisibleRootItem(), [&item] (QTreeWidgetItem* node)
-                    {
-                        return node == item;
-                    }))
+            // note : the items removed from the tree are removed from the index too
+            if(it.key()->treeWidget() == this)
             {
                 if (it.key()->toolTip(NetworkTree::TYPE_COLUMN) != nullptr) {
                     if( it.key()->toolTip(NetworkTree::TYPE_COLUMN) == "bi-directionnal" || it.key()->toolTip(NetworkTree::TYPE_COLUMN) == "receiver" || it.key()->toolTip(NetworkTree::TYPE_COLUMN) == "sender" ) {
@@ -2340,6 +2572,7 @@ NetworkTree::changeNameValue(QTreeWidgetItem *item, QString newValue)
           _endMessages->removeMessage(item);
           _OSCEndMessages->removeMessage(item);
           _OSCStartMessages->removeMessage(item);
+          unindexItems(item);
           item->parent()->removeChild(item);
 
           removeAssignItem(item);
@@ -2395,12 +2628,13 @@ NetworkTree::updateCurve(QTreeWidgetItem *item, unsigned int boxID, bool forceUp
       {
         unsigned int sampleRate = 0;
         bool redundancy = false, interpolate = false;
-        vector<float> values, xPercents, yValues, coeff;
+        CurveSamples values;
+        vector<float> xPercents, yValues, coeff;
         vector<string> argTypes;
         vector<short> sectionType;
 
         bool getCurveSuccess = Maquette::getInstance()->getCurveAttributes(boxID, address, 0, sampleRate, redundancy, interpolate, values, argTypes, xPercents, yValues, sectionType, coeff);
-        bool getCurveValuesSuccess = Maquette::getInstance()->getCurveValues(boxID, address, 0, yValues);
+        bool getCurveValuesSuccess = values != nullptr;
 
         if(!Maquette::getInstance()->curveIsManuallyActivated(boxID, address))
         {
@@ -2524,6 +2758,7 @@ NetworkTree::updateDeviceName(QString oldName, QString newName)
     if(currentItem()!=nullptr){
         if(currentItem()->text(NAME_COLUMN) == oldName){
             currentItem()->setText(NAME_COLUMN, newName);
+            reindexItems(currentItem());
             return;
         }        
     }
@@ -2540,6 +2775,7 @@ NetworkTree::updateDeviceName(QString oldName, QString newName)
             for(int i=0 ; i<items.size() ; i++){
                 if(items[i]->type() == DeviceNode){ //first deviceType found is set
                     items[i]->setText(NAME_COLUMN, newName);
+                    reindexItems(items[i]);
                     return;
                 }
             }
@@ -2563,6 +2799,7 @@ NetworkTree::updateDeviceProtocol(QString newName)
 {           
   QString deviceName = currentItem()->text(NAME_COLUMN);
   QTreeWidgetItem *item = currentItem();
+  unindexItems(item, false);
   item->takeChildren();
 
   if (newName == "OSC")
@@ -2599,7 +2836,7 @@ NetworkTree::updateDeviceNamespace(QString deviceName)
     }
 
     if (deviceItem != nullptr)
-        treeRecursiveExploration(deviceItem,false);
+        exploreItem(deviceItem);
 
 }
 
@@ -2633,6 +2870,10 @@ NetworkTree::getChildren(QTreeWidgetItem *item, QList<QTreeWidgetItem *> & items
     QTreeWidgetItem *child;
 
     if (!item->isDisabled()) {
+        if (hasPlaceholder(item)) {
+            exploreItem(item);
+        }
+
         int childrenCount = item->childCount();
         for (int i = 0; i < childrenCount; i++) {
             child = item->child(i);
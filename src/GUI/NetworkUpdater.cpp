@@ -1,87 +1,208 @@
 #include "NetworkUpdater.h"
-#include "DeviceEdit.hpp"
+#include "Maquette.hpp"
+#include <QRunnable>
 
-NetworkUpdater::NetworkUpdater(DeviceEdit *parent) :
-	QObject(nullptr),
-	ed(parent)
+/*!
+ * \brief Rebuilds the namespace of one device on the thread pool of the NetworkUpdater.
+ */
+class NamespaceDiscovery : public QRunnable
 {
-	//thrd.start();
-	//this->moveToThread(&thrd);
+	public:
+		NamespaceDiscovery(NetworkUpdater* updater, QString deviceName, bool updateBoxes, bool background, unsigned int requestId) :
+			updater(updater),
+			deviceName(deviceName),
+			updateBoxes(updateBoxes),
+			background(background),
+			requestId(requestId)
+		{
+		}
+
+		void run() override
+		{
+			updater->discover(deviceName, updateBoxes, background, requestId);
+		}
+
+	private:
+		NetworkUpdater* updater;
+		QString deviceName;
+		bool updateBoxes;
+		bool background;
+		unsigned int requestId;
+};
+
+NetworkUpdater::NetworkUpdater() :
+	QObject(nullptr)
+{
+	qRegisterMetaType<NetworkUpdate>("NetworkUpdate");
+
+	pool.setMaxThreadCount(MAX_DISCOVERIES);
+
+	thrd.start();
+	this->moveToThread(&thrd);
 }
 
 NetworkUpdater::~NetworkUpdater()
 {
-	//thrd.quit();
-	//thrd.wait();
+	pool.waitForDone();
+
+	thrd.quit();
+	thrd.wait();
+}
+
+void NetworkUpdater::cancel(unsigned int requestId)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	cancelledRequests.insert(requestId);
+
+	// a running request gives the tree back now : the device still answers the Engine call but its results are dropped
+	release(requestId);
+}
+
+bool NetworkUpdater::isCancelled(unsigned int requestId)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return cancelledRequests.count(requestId) != 0;
+}
+
+void NetworkUpdater::beginRequest(unsigned int requestId, bool disable)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	runningRequests[requestId] = disable;
+	if(disable && disablingRequests++ == 0)
+		emit disableTree();
+
+	emit started(requestId);
+}
+
+void NetworkUpdater::release(unsigned int requestId)
+{
+	auto request = runningRequests.find(requestId);
+	if(request == runningRequests.end())
+		return;
+
+	if(request->second && --disablingRequests == 0)
+		emit enableTree();
+
+	runningRequests.erase(request);
+
+	emit finished(requestId);
+}
+
+void NetworkUpdater::endRequest(unsigned int requestId)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	cancelledRequests.erase(requestId);
+	release(requestId);
 }
 
-void NetworkUpdater::update()
+void NetworkUpdater::dropRequest(unsigned int requestId)
 {
-	emit disableTree();
-	//setModal(false);
-	if(ed->_newDevice){
-        string          protocol = ed->_protocolsComboBox->currentText().toStdString(),
-                        name = ed->currentDevice(),
-                        ip   = ed->_localHostBox->text().toStdString();
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		cancelledRequests.erase(requestId);
+	}
 
-		unsigned int    destinationPort = ed->_portOutputBox->value(),
-						receptionPort = ed->_portInputBox->value();
+	emit finished(requestId);
+}
 
-		Maquette:: getInstance()->addNetworkDevice(name, protocol, ip, destinationPort, receptionPort);
-        emit newDeviceAdded(QString::fromStdString(name)); //sent to networkTree
+void NetworkUpdater::update(NetworkUpdate request, unsigned int requestId)
+{
+	if(isCancelled(requestId)){
+		dropRequest(requestId);
+		return;
+	}
+
+	beginRequest(requestId);
+
+	QString currentDevice = request.previousName;
 
-        ed->_currentDevice = QString::fromStdString(name);
+	if(request.newDevice){
+		emit progress(tr("Adding device %1").arg(QString::fromStdString(request.name)));
 
-		ed->_newDevice = false;
+		Maquette:: getInstance()->addNetworkDevice(request.name, request.protocol, request.localHost, request.destinationPort, request.receptionPort);
+		currentDevice = QString::fromStdString(request.name);
+
+		if(!isCancelled(requestId))
+			emit newDeviceAdded(currentDevice); //sent to networkTree
 	}
 
-	else if (ed->_changed) {
-		if (ed->_nameChanged) {
-            string name = ed->currentDevice();
-            Maquette::getInstance()->setDeviceName(ed->_currentDevice.toStdString(), name);
-            emit(deviceNameChanged(ed->_currentDevice, QString::fromStdString(ed->currentDevice())));
-            ed->_currentDevice = QString::fromStdString(name);
+	else if (request.changed) {
+		emit progress(tr("Updating device %1").arg(currentDevice));
+
+		if (request.nameChanged) {
+			Maquette::getInstance()->setDeviceName(currentDevice.toStdString(), request.name);
+			emit(deviceNameChanged(currentDevice, QString::fromStdString(request.name)));
+			currentDevice = QString::fromStdString(request.name);
 		}
-		if (ed->_localHostChanged) {
-			Maquette::getInstance()->setDeviceLocalHost(ed->_currentDevice.toStdString(), ed->_localHostBox->text().toStdString());
+		if (request.localHostChanged) {
+			Maquette::getInstance()->setDeviceLocalHost(currentDevice.toStdString(), request.localHost);
 		}
-		if (ed->_networkPortChanged) {
-			Maquette::getInstance()->setDevicePort(ed->_currentDevice.toStdString(), ed->_portOutputBox->value(), ed->_portInputBox->value());
+		if (request.networkPortChanged) {
+			Maquette::getInstance()->setDevicePort(currentDevice.toStdString(), request.destinationPort, request.receptionPort);
 		}
-		if (ed->_protocolChanged) {
-			Maquette::getInstance()->setDeviceProtocol(ed->_currentDevice.toStdString(), ed->_protocolsComboBox->currentText().toStdString());
+		if (request.protocolChanged) {
+			Maquette::getInstance()->setDeviceProtocol(currentDevice.toStdString(), request.protocol);
 //            emit(deviceProtocolChanged(_protocolsComboBox->currentText()));
 		}
-		emit deviceChanged(ed->_currentDevice);
+		if(!isCancelled(requestId))
+			emit deviceChanged(currentDevice);
 	}
 
 
-	if(ed->_namespacePathChanged){
+	if(request.namespacePathChanged && !isCancelled(requestId)){
+		emit progress(tr("Loading the namespace of %1").arg(currentDevice));
 
 		//check if currentDevice ok
-		if(Maquette::getInstance()->isNetworkDeviceRequestable(ed->_currentDevice.toStdString()) == 0){
+		if(Maquette::getInstance()->isNetworkDeviceRequestable(currentDevice.toStdString()) == 0){
 
 			//load
-			if(!Maquette::getInstance()->loadNetworkNamespace(ed->_currentDevice.toStdString(),ed->_namespaceFilePath->text().toStdString())){
-				emit namespaceLoaded(ed->_currentDevice);
-				ed->_namespaceFilePath->clear();
+			if(!Maquette::getInstance()->loadNetworkNamespace(currentDevice.toStdString(), request.namespaceFilePath)){
+				if(!isCancelled(requestId))
+					emit namespaceLoaded(currentDevice);
 			}
 			else{
-				QMessageBox::warning(ed, "", tr("Cannot load namespace file"));
+				emit namespaceLoadFailed(tr("Cannot load namespace file"));
 			}
 		}
 
 		else{
-			QMessageBox::warning(ed, "", tr("Cannot load namespace file - please verify your device's parameters"));
+			emit namespaceLoadFailed(tr("Cannot load namespace file - please verify your device's parameters"));
 		}
 	}
 
-	ed->_changed = false;
-	ed->_nameChanged = false;
-	ed->_protocolChanged = false;
-	ed->_localHostChanged = false;
-	ed->_networkPortChanged = false;
-	ed->_namespacePathChanged = false;
-	
-	emit enableTree();
+	endRequest(requestId);
+}
+
+void NetworkUpdater::rebuildNamespace(QString deviceName, bool updateBoxes, bool background, unsigned int requestId)
+{
+	if(isCancelled(requestId)){
+		emit namespaceRebuildFailed(deviceName);
+		dropRequest(requestId);
+		return;
+	}
+
+	pool.start(new NamespaceDiscovery(this, deviceName, updateBoxes, background, requestId));
+}
+
+void NetworkUpdater::discover(QString deviceName, bool updateBoxes, bool background, unsigned int requestId)
+{
+	// the request could have been cancelled while it was waiting for a thread of the pool
+	if(isCancelled(requestId)){
+		emit namespaceRebuildFailed(deviceName);
+		dropRequest(requestId);
+		return;
+	}
+
+	// a background rebuild leaves the tree usable : the items of the device are only replaced when it is done
+	beginRequest(requestId, !background);
+
+	emit progress(tr("Scanning the namespace of %1").arg(deviceName));
+
+	// the tree keeps the items of the device until the rebuild succeeded (namespaceRebuildFailed is only emitted once the Engine call returned)
+	if(!Maquette::getInstance()->rebuildNetworkNamespace(deviceName.toStdString()) && !isCancelled(requestId))
+		emit namespaceRebuilt(deviceName, updateBoxes);
+	else
+		emit namespaceRebuildFailed(deviceName);
+
+	endRequest(requestId);
 }
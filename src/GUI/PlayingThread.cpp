@@ -75,10 +75,21 @@ void PlayingThread::stop()
 
 void PlayingThread::update()
 {
-  if(!_scene->getPlayingBoxes().empty() || _scene->playing())
+  // the boxes and the trigger points are updated before the execution state is read :
+  // the slots called from here can read it too
+  _scene->processExecutionEvents();
+
+  // the execution state is read once per frame : painting never waits for the scheduler
+  const ExecutionState &state = _scene->getExecutionState();
+
+  if(!_scene->getPlayingBoxes().empty() || (state.running && !state.paused))
   {
-    _scene->updatePlayingBoxes();
-    _scene->updateProgressBar();
+    // nothing to repaint while the view is hidden : the next frame catches up
+    if(!_scene->isDisplayed())
+      return;
+
+    _scene->updatePlayingBoxes(state);
+    _scene->updateProgressBar(state);
   }
   else
   {
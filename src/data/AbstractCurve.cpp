@@ -50,10 +50,10 @@ using std::pair;
 using std::vector;
 
 AbstractCurve::AbstractCurve(unsigned int boxID, const std::string &address, unsigned int argPosition,
-                             unsigned int sampleRate, bool redundancy, bool show, bool interpolate, float /*lastPointCoeff*/, const vector<float> &curve,
+                             unsigned int sampleRate, bool redundancy, bool show, bool interpolate, float /*lastPointCoeff*/, const CurveSamples &curve,
                              const map<float, pair<float, float> > &breakpoints) :
   _boxID(boxID), _address(address), _argPosition(argPosition), _sampleRate(sampleRate), _redundancy(redundancy), _show(show),
-  _interpolate(interpolate), _curve(curve), _breakpoints(breakpoints)
+  _interpolate(interpolate), _curve(curve ? curve : std::make_shared<std::vector<float> >()), _breakpoints(breakpoints)
 {}
 
 AbstractCurve::AbstractCurve(const AbstractCurve &other) :
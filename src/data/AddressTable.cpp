@@ -0,0 +1,163 @@
+/*
+ * Process-wide table of interned network addresses
+ * Copyright © 2026, agent
+ *
+ * License: This code is licensed under the terms of the "CeCILL-C"
+ * http://www.cecill.info
+ */
+
+#include "AddressTable.hpp"
+
+/*!
+ * \file AddressTable.cpp
+ * \author agent
+ * \date 2026
+ */
+
+AddressTable::AddressTable()
+{
+    // the first entry is reserved for NO_ADDRESS_ID
+    m_entries.push_back(Entry());
+    m_entries.back().ttAddress = kTTAdrsEmpty;
+}
+
+AddressTable& AddressTable::getInstance()
+{
+    static AddressTable table;
+
+    return table;
+}
+
+AddressId AddressTable::append(const std::string& address, TTAddress& aTTAddress)
+{
+    AddressId id = m_entries.size();
+
+    m_entries.push_back(Entry());
+    m_entries.back().address = address;
+    m_entries.back().ttAddress = aTTAddress;
+
+    // never replace the id already given to an address
+    m_ids.insert(std::make_pair(address, id));
+    m_ttIds.insert(std::make_pair(std::string(aTTAddress.c_str()), id));
+
+    return id;
+}
+
+AddressId AddressTable::intern(const std::string& address)
+{
+    if (address.empty())
+        return NO_ADDRESS_ID;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::unordered_map<std::string, AddressId>::iterator it = m_ids.find(address);
+    if (it != m_ids.end())
+        return it->second;
+
+    TTAddress anAddress = toTTAddress(address);
+    AddressId id;
+
+    // several spellings of an address (with a trailing slash, ...) share the same id
+    it = m_ttIds.find(anAddress.c_str());
+    if (it != m_ttIds.end())
+        id = it->second;
+    else {
+        std::string normalized = toNetworkTreeAddress(anAddress);
+
+        // the normalized spelling could have been interned from its network tree form
+        it = m_ids.find(normalized);
+        if (it != m_ids.end()) {
+            id = it->second;
+            m_ttIds[anAddress.c_str()] = id;
+        }
+        else
+            id = append(normalized, anAddress);
+    }
+
+    m_ids[address] = id;
+
+    return id;
+}
+
+AddressId AddressTable::intern(TTAddress aTTAddress)
+{
+    if (aTTAddress == kTTAdrsEmpty)
+        return NO_ADDRESS_ID;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::unordered_map<std::string, AddressId>::iterator it = m_ttIds.find(aTTAddress.c_str());
+    if (it != m_ttIds.end())
+        return it->second;
+
+    std::string address = toNetworkTreeAddress(aTTAddress);
+
+    // the same address could have been interned from its network tree form
+    it = m_ids.find(address);
+    if (it != m_ids.end()) {
+        m_ttIds[aTTAddress.c_str()] = it->second;
+        return it->second;
+    }
+
+    return append(address, aTTAddress);
+}
+
+AddressId AddressTable::find(const std::string& address)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::unordered_map<std::string, AddressId>::iterator it = m_ids.find(address);
+    if (it != m_ids.end())
+        return it->second;
+
+    return NO_ADDRESS_ID;
+}
+
+const std::string& AddressTable::address(AddressId id)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // note : references stay valid because a deque doesn't move its elements when growing at the end
+    if (id >= m_entries.size())
+        return m_entries[NO_ADDRESS_ID].address;
+
+    return m_entries[id].address;
+}
+
+const TTAddress& AddressTable::ttAddress(AddressId id)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (id >= m_entries.size())
+        return m_entries[NO_ADDRESS_ID].ttAddress;
+
+    return m_entries[id].ttAddress;
+}
+
+TTAddress AddressTable::toTTAddress(const std::string& networktreeAddress)
+{
+    TTSymbol            temp(networktreeAddress);
+    TTAddress           address(temp);
+    TTAddress           applicationName, anAddress;
+    TTString            s;
+
+    // split the address to get application name and then an address
+    address.splitAt(0, applicationName, anAddress);
+
+    // edit applicationName:/anAddress
+    s = applicationName.string();
+    s += S_DIRECTORY.string();
+
+    if (anAddress != kTTAdrsEmpty)
+        s += anAddress.string();
+
+    return TTAddress(s);
+}
+
+std::string AddressTable::toNetworkTreeAddress(TTAddress aTTAddress)
+{
+    std::string s = aTTAddress.getDirectory().string().c_str();
+    s += aTTAddress.normalize().string();
+
+    return s;
+}
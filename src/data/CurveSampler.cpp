@@ -0,0 +1,323 @@
+/*
+ * Native sampler for the power section curves
+ * Copyright © 2026, agent
+ *
+ * License: This code is licensed under the terms of the "CeCILL-C"
+ * http://www.cecill.info
+ */
+
+#include "CurveSampler.hpp"
+
+/*!
+ * \file CurveSampler.cpp
+ * \author agent
+ * \date 2026
+ */
+
+#include <cmath>
+#include <algorithm>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CURVE_SAMPLER_SSE2
+#endif
+
+namespace {
+
+/*
+ * The vectorized sampling is written once on top of a traits class giving the few operations needed
+ * for each instruction set (Avx2 or Sse2). Logarithm and exponential are the single precision polynomial
+ * approximations of the Cephes library, accurate enough for values sent as floats.
+ */
+#if defined(__AVX2__)
+
+struct Avx2 {
+
+    typedef __m256  V;
+    typedef __m256i I;
+    enum { width = 8 };
+
+    static V set(float f)           { return _mm256_set1_ps(f); }
+    static V add(V a, V b)          { return _mm256_add_ps(a, b); }
+    static V sub(V a, V b)          { return _mm256_sub_ps(a, b); }
+    static V mul(V a, V b)          { return _mm256_mul_ps(a, b); }
+    static V min(V a, V b)          { return _mm256_min_ps(a, b); }
+    static V max(V a, V b)          { return _mm256_max_ps(a, b); }
+    static V bitAnd(V a, V b)       { return _mm256_and_ps(a, b); }
+    static V bitOr(V a, V b)        { return _mm256_or_ps(a, b); }
+    static V lessThan(V a, V b)     { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static V greaterThan(V a, V b)  { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    static V floor(V a)             { return _mm256_floor_ps(a); }
+    static V select(V mask, V a, V b) { return _mm256_blendv_ps(b, a, mask); }
+
+    /** split a positive float into a mantissa in [0.5, 1[ and an exponent (as frexp does) */
+    static V frexp(V a, V& exponent)
+    {
+        I i = _mm256_srli_epi32(_mm256_castps_si256(a), 23);
+        exponent = _mm256_cvtepi32_ps(_mm256_sub_epi32(i, _mm256_set1_epi32(126)));
+        return _mm256_or_ps(_mm256_and_ps(a, _mm256_castsi256_ps(_mm256_set1_epi32(~0x7f800000))), set(0.5f));
+    }
+
+    /** compute 2^n for an integral n */
+    static V pow2n(V n)
+    {
+        I i = _mm256_add_epi32(_mm256_cvttps_epi32(n), _mm256_set1_epi32(127));
+        return _mm256_castsi256_ps(_mm256_slli_epi32(i, 23));
+    }
+
+    static V index(unsigned int i)
+    {
+        float f = float(i);
+        return _mm256_setr_ps(f, f + 1.f, f + 2.f, f + 3.f, f + 4.f, f + 5.f, f + 6.f, f + 7.f);
+    }
+
+    static void store(float* p, V a) { _mm256_storeu_ps(p, a); }
+};
+
+typedef Avx2 SimdTraits;
+#define CURVE_SAMPLER_INSTRUCTION_SET "avx2"
+
+#elif defined(CURVE_SAMPLER_SSE2)
+
+struct Sse2 {
+
+    typedef __m128  V;
+    typedef __m128i I;
+    enum { width = 4 };
+
+    static V set(float f)           { return _mm_set1_ps(f); }
+    static V add(V a, V b)          { return _mm_add_ps(a, b); }
+    static V sub(V a, V b)          { return _mm_sub_ps(a, b); }
+    static V mul(V a, V b)          { return _mm_mul_ps(a, b); }
+    static V min(V a, V b)          { return _mm_min_ps(a, b); }
+    static V max(V a, V b)          { return _mm_max_ps(a, b); }
+    static V bitAnd(V a, V b)       { return _mm_and_ps(a, b); }
+    static V bitOr(V a, V b)        { return _mm_or_ps(a, b); }
+    static V lessThan(V a, V b)     { return _mm_cmplt_ps(a, b); }
+    static V greaterThan(V a, V b)  { return _mm_cmpgt_ps(a, b); }
+    static V select(V mask, V a, V b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+
+    static V floor(V a)
+    {
+        // no _mm_floor_ps before SSE4.1 : truncate then fix the negative values
+        V t = _mm_cvtepi32_ps(_mm_cvttps_epi32(a));
+        return _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, a), set(1.f)));
+    }
+
+    /** split a positive float into a mantissa in [0.5, 1[ and an exponent (as frexp does) */
+    static V frexp(V a, V& exponent)
+    {
+        I i = _mm_srli_epi32(_mm_castps_si128(a), 23);
+        exponent = _mm_cvtepi32_ps(_mm_sub_epi32(i, _mm_set1_epi32(126)));
+        return _mm_or_ps(_mm_and_ps(a, _mm_castsi128_ps(_mm_set1_epi32(~0x7f800000))), set(0.5f));
+    }
+
+    /** compute 2^n for an integral n */
+    static V pow2n(V n)
+    {
+        I i = _mm_add_epi32(_mm_cvttps_epi32(n), _mm_set1_epi32(127));
+        return _mm_castsi128_ps(_mm_slli_epi32(i, 23));
+    }
+
+    static V index(unsigned int i)
+    {
+        float f = float(i);
+        return _mm_setr_ps(f, f + 1.f, f + 2.f, f + 3.f);
+    }
+
+    static void store(float* p, V a) { _mm_storeu_ps(p, a); }
+};
+
+typedef Sse2 SimdTraits;
+#define CURVE_SAMPLER_INSTRUCTION_SET "sse2"
+
+#else
+
+#define CURVE_SAMPLER_INSTRUCTION_SET "scalar"
+
+#endif
+
+#if defined(__AVX2__) || defined(CURVE_SAMPLER_SSE2)
+
+/** natural logarithm of strictly positive values */
+template <typename S>
+typename S::V simdLog(typename S::V x)
+{
+    typedef typename S::V V;
+    V e;
+
+    x = S::frexp(x, e);
+
+    // x in [sqrt(1/2), sqrt(2)[ and x - 1 as the polynomial variable
+    V mask = S::lessThan(x, S::set(0.707106781186547524f));
+    e = S::sub(e, S::bitAnd(mask, S::set(1.f)));
+    x = S::sub(S::add(x, S::bitAnd(mask, x)), S::set(1.f));
+
+    V z = S::mul(x, x);
+    V y = S::set(7.0376836292E-2f);
+    y = S::add(S::mul(y, x), S::set(-1.1514610310E-1f));
+    y = S::add(S::mul(y, x), S::set(1.1676998740E-1f));
+    y = S::add(S::mul(y, x), S::set(-1.2420140846E-1f));
+    y = S::add(S::mul(y, x), S::set(1.4249322787E-1f));
+    y = S::add(S::mul(y, x), S::set(-1.6668057665E-1f));
+    y = S::add(S::mul(y, x), S::set(2.0000714765E-1f));
+    y = S::add(S::mul(y, x), S::set(-2.4999993993E-1f));
+    y = S::add(S::mul(y, x), S::set(3.3333331174E-1f));
+    y = S::mul(S::mul(y, x), z);
+
+    y = S::add(y, S::mul(e, S::set(-2.12194440E-4f)));
+    y = S::sub(y, S::mul(z, S::set(0.5f)));
+    x = S::add(x, y);
+
+    return S::add(x, S::mul(e, S::set(0.693359375f)));
+}
+
+/** exponential of values lower than 88 */
+template <typename S>
+typename S::V simdExp(typename S::V x)
+{
+    typedef typename S::V V;
+
+    x = S::max(x, S::set(-87.3f));
+
+    // x = n * ln(2) + r with r in [-ln(2)/2, ln(2)/2]
+    V n = S::floor(S::add(S::mul(x, S::set(1.44269504088896341f)), S::set(0.5f)));
+    x = S::sub(x, S::mul(n, S::set(0.693359375f)));
+    x = S::sub(x, S::mul(n, S::set(-2.12194440E-4f)));
+
+    V z = S::mul(x, x);
+    V y = S::set(1.9875691500E-4f);
+    y = S::add(S::mul(y, x), S::set(1.3981999507E-3f));
+    y = S::add(S::mul(y, x), S::set(8.3334519073E-3f));
+    y = S::add(S::mul(y, x), S::set(4.1665795894E-2f));
+    y = S::add(S::mul(y, x), S::set(1.6666665459E-1f));
+    y = S::add(S::mul(y, x), S::set(5.0000001201E-1f));
+    y = S::add(S::add(S::mul(y, z), x), S::set(1.f));
+
+    return S::mul(y, S::pow2n(n));
+}
+
+/** sample a section by blocks and return the index of the first sample left to the scalar version */
+template <typename S>
+unsigned int simdSection(const CurvePoint& a, const CurvePoint& b, float step, float* output, unsigned int begin, unsigned int end)
+{
+    typedef typename S::V V;
+
+    const V     x0 = S::set(a.x);
+    const V     scale = S::set(1.f / (b.x - a.x));
+    const V     y0 = S::set(a.y);
+    const V     dy = S::set(b.y - a.y);
+    const V     vstep = S::set(step);
+    const V     power = S::set(b.power);
+    const V     zero = S::set(0.f);
+    const V     one = S::set(1.f);
+    const bool  linear = b.power == 1.f;
+    unsigned int i;
+
+    for (i = begin; i + S::width <= end; i += S::width) {
+
+        V t = S::mul(S::sub(S::mul(S::index(i), vstep), x0), scale);
+        t = S::min(S::max(t, zero), one);
+
+        if (!linear) {
+
+            // t^power = exp(power * log(t)) and 0^power = 0
+            V p = simdExp<S>(S::mul(power, simdLog<S>(t)));
+            t = S::select(S::greaterThan(t, zero), p, zero);
+        }
+
+        S::store(output + i, S::add(y0, S::mul(dy, t)));
+    }
+
+    return i;
+}
+
+#endif
+
+}
+
+bool CurveSampler::sample(const CurvePoints& points, float* output, unsigned int nbSamples)
+{
+    return sample(points, output, nbSamples, true);
+}
+
+bool CurveSampler::sampleScalar(const CurvePoints& points, float* output, unsigned int nbSamples)
+{
+    return sample(points, output, nbSamples, false);
+}
+
+const char* CurveSampler::instructionSet()
+{
+    return CURVE_SAMPLER_INSTRUCTION_SET;
+}
+
+bool CurveSampler::sample(const CurvePoints& points, float* output, unsigned int nbSamples, bool vectorized)
+{
+    unsigned int    i = 0, end;
+    double          step;
+
+    if (points.empty())
+        return false;
+
+    step = nbSamples > 1 ? 1. / (nbSamples - 1) : 0.;
+
+    // hold the first value before the first point
+    while (i < nbSamples && i * step < points.front().x)
+        output[i++] = points.front().y;
+
+    for (CurvePoints::size_type k = 1; k < points.size() && i < nbSamples; k++) {
+
+        const CurvePoint& a = points[k - 1];
+        const CurvePoint& b = points[k];
+
+        // the samples until the end of the section (included)
+        end = step > 0. ? std::min(nbSamples, (unsigned int)std::max(0., std::floor(b.x / step)) + 1) : nbSamples;
+
+        if (end <= i)
+            continue;
+
+        if (b.x <= a.x)
+            std::fill(output + i, output + end, b.y);
+
+        else if (vectorized)
+            sampleSection(a, b, float(step), output, i, end);
+
+        else
+            sampleSectionScalar(a, b, float(step), output, i, end);
+
+        i = end;
+    }
+
+    // hold the last value after the last point
+    while (i < nbSamples)
+        output[i++] = points.back().y;
+
+    return true;
+}
+
+void CurveSampler::sampleSection(const CurvePoint& a, const CurvePoint& b, float step, float* output, unsigned int begin, unsigned int end)
+{
+#if defined(__AVX2__) || defined(CURVE_SAMPLER_SSE2)
+    begin = simdSection<SimdTraits>(a, b, step, output, begin, end);
+#endif
+
+    sampleSectionScalar(a, b, step, output, begin, end);
+}
+
+void CurveSampler::sampleSectionScalar(const CurvePoint& a, const CurvePoint& b, float step, float* output, unsigned int begin, unsigned int end)
+{
+    float scale = 1.f / (b.x - a.x);
+    float dy = b.y - a.y;
+
+    for (unsigned int i = begin; i < end; i++) {
+
+        float t = std::min(std::max((i * step - a.x) * scale, 0.f), 1.f);
+
+        if (b.power != 1.f)
+            t = t > 0.f ? std::pow(t, b.power) : 0.f;
+
+        output[i] = a.y + dy * t;
+    }
+}
@@ -7,9 +7,14 @@
  */
 
 #include "Engine.h"
+#include "CurveSampler.hpp"
 
 #include <stdio.h>
 #include <math.h>
+#include <algorithm>
+#include <set>
+#include <queue>
+#include <fstream>
 #include <QDebug>
 
 using namespace std;
@@ -20,7 +25,10 @@ using namespace std;
  * \date 2012-2013
  */
 
-EngineCacheElement::EngineCacheElement()
+EngineCacheElement::EngineCacheElement() :
+index(NO_ID),
+parent(NO_ID),
+curveEdits(0)
 {
     ;
 }
@@ -30,6 +38,67 @@ EngineCacheElement::~EngineCacheElement()
     ;
 }
 
+/** log an unknown or stale id and return an empty element instead of creating a new one */
+static EngineCacheElement& unknownCacheElement(const char* method, unsigned int id)
+{
+    static EngineCacheElement empty;
+    
+    TTLogError("Engine::%s : unknown or stale id %ld\n", method, id);
+    
+    // the empty element could have been modified through a returned reference
+    empty = EngineCacheElement();
+    
+    return empty;
+}
+
+/** convert the function parameters of a curve (x1 y1 b1 x2 y2 b2 ...) into points for the CurveSampler */
+static bool toCurvePoints(const TTValue& parameters, CurvePoints& points)
+{
+    if (parameters.size() == 0 || parameters.size() % 3 != 0)
+        return false;
+    
+    points.clear();
+    points.reserve(parameters.size() / 3);
+    
+    for (TTUInt32 i = 0; i < parameters.size(); i = i+3)
+        points.push_back(CurvePoint(TTFloat64(parameters[i]), TTFloat64(parameters[i+1]), TTFloat64(parameters[i+2])));
+    
+    return true;
+}
+
+/** set the priority, service, tags, rangeBounds and rangeClipmode attributes as the cached attributes of a distant application (read by requestNetworkNamespaceDump) */
+static void setCachedAttributes(TTObject& anApplication)
+{
+    TTValue args;
+    
+    args = kTTSym_priority;
+    args.append(kTTSym_service);
+    args.append(kTTSym_tags);
+    args.append(kTTSym_rangeBounds);
+    args.append(kTTSym_rangeClipmode);
+    anApplication.set("cachedAttributes", args);
+}
+
+/** convert the sections edited by i-score (x in percents, y and coeff) into points : the power of a section is its coeff ^ 4 */
+static void sectionsToCurvePoints(const std::vector<float>& percent, const std::vector<float>& y, const std::vector<float>& coeff, CurvePoints& points)
+{
+    points.clear();
+    points.reserve(coeff.size());
+    
+    for (std::vector<float>::size_type i = 0; i < coeff.size(); i++) {
+        
+        TTFloat64 c = coeff[i];
+        
+        points.push_back(CurvePoint(percent[i] / 100., y[i], c * c * c * c));
+    }
+}
+
+/** the number of values sent by a curve during a duration (in ms) at a sample rate (in values per second) */
+static unsigned int curveSamplesCount(TimeValue duration, unsigned int sampleRate)
+{
+    return std::max(2u, (unsigned int)((TTUInt64(duration) * sampleRate) / 1000) + 1);
+}
+
 Engine::Engine(void(*timeEventStatusAttributeCallback)(ConditionedTimeBoxId, bool),
                void(*automationSchedulerRunningAttributeCallback)(TimeBoxId, bool),
                void(*transportDataValueCallback)(TTSymbol&, const TTValue&),
@@ -43,9 +112,14 @@ Engine::Engine(void(*timeEventStatusAttributeCallback)(ConditionedTimeBoxId, boo
     m_NetworkDeviceNamespaceCallback = networkDeviceNamespaceCallback;
     m_NetworkDeviceConnectionError = networkDeviceConnectionError;
     
-    m_nextTimeBoxId = 1;
-    m_nextIntervalId = 1;
-    m_nextConditionedTimeBoxId = 1;
+    m_editing = false;
+    m_attributeCacheTTL = std::chrono::milliseconds(ATTRIBUTE_CACHE_TTL);
+    m_attributeCacheEpoch = 0;
+    m_curveSamplerChecks = 0;
+    m_curveSamplerPowerChecked = false;
+    m_executionStateSampling = false;
+    m_executionEventsOverflow = false;
+    m_executionStateOverflow = false;
     
     iscore = TTSymbol("i-score");
     
@@ -96,6 +170,7 @@ void Engine::initModular(const char* pathToTheJamomaFolder)
     m_sender = TTObject("Sender");
     
     registerIscoreToProtocols();
+    registerIscoreTransportData();
 }
 
 void Engine::registerIscoreToProtocols()
@@ -187,6 +262,39 @@ void Engine::registerIscoreToProtocols()
 	}
 }
 
+void Engine::registerIscoreTransportData()
+{
+    TTObject    aData;
+    TTValue     args, out;
+    
+    // the transport features with the type of their value (see transportCallback in the Maquette)
+    const char* features[][3] = {
+        {"Play",        "none",     "start or resume the execution"},
+        {"Stop",        "none",     "stop the execution"},
+        {"Pause",       "none",     "pause or resume the execution"},
+        {"Rewind",      "none",     "stop the execution and go back to the start"},
+        {"StartPoint",  "generic",  "the date where the next execution starts (in ms)"},
+        {"Speed",       "generic",  "the speed factor of the execution"}};
+    
+    TTLogMessage("\n*** Registration of i-score transport data ***\n");
+    ////////////////////////////////////////////////////////////////////////
+    
+    for (auto& feature : features) {
+        
+        // a data notifies TransportDataValueCallback each time it receives a value
+        aData = TTObject("Data", kTTSym_message);
+        aData.set("baton", TTValue(TTPtr(this), TTSymbol(feature[0])));
+        aData.set("function", TTPtr(&TransportDataValueCallback));
+        aData.set("type", TTSymbol(feature[1]));
+        aData.set("description", TTSymbol(feature[2]));
+        
+        args = TTValue(TTAddress((std::string("/Transport/") + feature[0]).c_str()), aData);
+        m_iscore.send("ObjectRegister", args, out);
+        
+        m_transportData.push_back(aData);
+    }
+}
+
 void Engine::initScore(const char* pathToTheJamomaFolder)
 {   
     TTValue     args, out;
@@ -235,6 +343,9 @@ void Engine::dumpAddressBelow(TTNodePtr aNode)
 
 Engine::~Engine()
 {
+    // the sampling thread reads the scheduler : stop it first
+    stopExecutionStateSampling();
+    
     // Clear all the EngineCacheMaps
     // note : this should be useless because all elements are removed by the maquette
     clearTimeCondition();
@@ -265,22 +376,26 @@ Engine::~Engine()
     }
 }
 
-TimeBoxId Engine::cacheTimeBox(TTObject& automation, TTAddress& anAddress, TTObject& subScenario)
+TimeBoxId Engine::cacheTimeBox(TTObject& automation, TTAddress& anAddress, TTObject& subScenario, TimeBoxId parentId)
 {
     TimeBoxId id;
-    EngineCacheElementPtr e;
+    EngineCacheElement e;
+    EngineCacheElementPtr parent;
     
-    e = new EngineCacheElement();
-    e->object = automation;
-    e->address = anAddress;
-    e->subScenario = subScenario;
+    e.object = automation;
+    e.address = anAddress;
+    e.subScenario = subScenario;
+    e.parent = parentId;
     
-    TTValue out, args = TTValue(e->address, e->object);
+    TTValue out, args = TTValue(e.address, e.object);
     m_iscore.send("ObjectRegister", args, out);
     
-    id = m_nextTimeBoxId;
-    m_timeBoxMap[id] = e;
-    m_nextTimeBoxId++;
+    id = m_timeBoxMap.insert(e);
+    
+    // update the hierarchy
+    parent = m_timeBoxMap.find(parentId);
+    if (parent)
+        parent->children.push_back(id);
     
     cacheStartCallback(id);
     cacheEndCallback(id);
@@ -288,172 +403,304 @@ TimeBoxId Engine::cacheTimeBox(TTObject& automation, TTAddress& anAddress, TTObj
     return id;
 }
 
+EngineCacheElement& Engine::getTimeBoxElement(TimeBoxId boxId, const char* method)
+{
+    EngineCacheElementPtr e = m_timeBoxMap.find(boxId);
+    
+    if (!e)
+        return unknownCacheElement(method, boxId);
+    
+    return *e;
+}
+
+bool Engine::isTimeBoxCached(TimeBoxId boxId)
+{
+    return m_timeBoxMap.contains(boxId);
+}
+
 TTObject& Engine::getMainProcess(TimeBoxId boxId)
 {
-    if (m_timeBoxMap[boxId]->loop.valid())
-        return m_timeBoxMap[boxId]->loop;
+    EngineCacheElement& e = getTimeBoxElement(boxId, "getMainProcess");
+    
+    if (e.loop.valid())
+        return e.loop;
     
-    return m_timeBoxMap[boxId]->object;
+    return e.object;
 }
 
 TTObject& Engine::getAutomation(TimeBoxId boxId)
 {
-    return m_timeBoxMap[boxId]->object;
+    return getTimeBoxElement(boxId, "getAutomation").object;
 }
 
 TTObject& Engine::getSubScenario(TimeBoxId boxId)
 {
-    return m_timeBoxMap[boxId]->subScenario;
+    return getTimeBoxElement(boxId, "getSubScenario").subScenario;
 }
 
 void Engine::setLoop(TimeBoxId boxId, TTObject& loop)
 {
-    m_timeBoxMap[boxId]->loop = loop;
+    EngineCacheElementPtr e = m_timeBoxMap.find(boxId);
+    
+    if (e)
+        e->loop = loop;
+    else
+        unknownCacheElement("setLoop", boxId);
 }
 
 TTObject& Engine::getLoop(TimeBoxId boxId)
 {
-    return m_timeBoxMap[boxId]->loop;
+    return getTimeBoxElement(boxId, "getLoop").loop;
 }
 
 TTAddress& Engine::getAddress(TimeBoxId boxId)
 {
-    return m_timeBoxMap[boxId]->address;
+    return getTimeBoxElement(boxId, "getAddress").address;
 }
 
 TimeBoxId Engine::getParentId(TimeBoxId boxId)
 {
-    EngineCacheMapIterator it;
-    TimeBoxId   parentId = NO_ID;
-    TTObject    parentScenario;
-    TTValue     v;
+    EngineCacheElementPtr e = m_timeBoxMap.find(boxId);
     
-    if (m_timeBoxMap[boxId]->loop.valid())
-        m_timeBoxMap[boxId]->loop.get("container", v);
-    else
-        m_timeBoxMap[boxId]->object.get("container", v);
+    if (!e)
+        return NO_ID;
+    
+    return e->parent;
+}
+
+TimeValue Engine::getBoxAbsoluteBeginTime(TimeBoxId boxId)
+{
+    TimeValue   date = 0;
     
-    parentScenario = v[0];
+    // the begin time of a box is relative to the scenario containing it
+    for (; boxId != NO_ID && boxId != ROOT_BOX_ID; boxId = getParentId(boxId))
+        date += getBoxBeginTime(boxId);
     
-    // retreive the id of the scenario
-    for (it = m_timeBoxMap.begin(); it != m_timeBoxMap.end(); ++it)
+    return date;
+}
+
+bool Engine::isBoxMutedInScore(TimeBoxId boxId)
+{
+    // a box is silent if it or one of the boxes containing it is muted
+    for (; boxId != NO_ID && boxId != ROOT_BOX_ID; boxId = getParentId(boxId))
+        if (getBoxMuteState(boxId))
+            return true;
+    
+    return false;
+}
+
+void Engine::getChildrenId(TimeBoxId boxId, vector<TimeBoxId>& childrenId)
+{
+    EngineCacheElementPtr e = m_timeBoxMap.find(boxId);
+    
+    if (!e)
+        return;
+    
+    childrenId.insert(childrenId.end(), e->children.begin(), e->children.end());
+}
+
+void Engine::snapshotRelatedDates(const std::vector<TimeBoxId>& boxesId, MovedTimeBoxes& dates)
+{
+    std::set<TimeBoxId>     reached(boxesId.begin(), boxesId.end());
+    std::vector<TimeBoxId>  toVisit(boxesId);
+    TTValue                 v;
+    
+    // only the boxes linked to the given ones by temporal relations can be moved by the solver
+    while (!toVisit.empty())
     {
-        if (it->second->subScenario == parentScenario)
+        TimeBoxId               boxId = toVisit.back();
+        EngineCacheElementPtr   e = m_timeBoxMap.find(boxId);
+        
+        toVisit.pop_back();
+        
+        if (!e)
+            continue;
+        
+        TTObject mainProcess = e->loop.valid() ? e->loop : e->object;
+        TimeValue start, end;
+        
+        mainProcess.get("startDate", v);
+        start = v[0];
+        
+        mainProcess.get("endDate", v);
+        end = v[0];
+        
+        dates.push_back(MovedTimeBox(boxId, start, end));
+        
+        for (std::vector<IntervalId>::iterator it = e->relations.begin(); it != e->relations.end(); ++it)
         {
-            parentId = it->first;
-            break;
+            EngineCacheElementPtr interval = m_intervalMap.find(*it);
+            
+            if (!interval)
+                continue;
+            
+            for (std::vector<TimeBoxId>::iterator linked = interval->relations.begin(); linked != interval->relations.end(); ++linked)
+                if (reached.insert(*linked).second)
+                    toVisit.push_back(*linked);
         }
     }
-    
-    return parentId;
 }
 
-void Engine::getChildrenId(TimeBoxId boxId, vector<TimeBoxId>& childrenId)
+void Engine::getMovedBoxes(const MovedTimeBoxes& datesBefore, MovedTimeBoxes& movedBoxes)
 {
-    EngineCacheMapIterator it;
-    TTObject    subScenario = getSubScenario(boxId);
-    TTObject    parentScenario;
-    TTValue     v;
+    TTValue v;
     
-    // Get all boxes id that have the subScenario as parent
-    for (it = m_timeBoxMap.begin(); it != m_timeBoxMap.end(); ++it)
+    for (MovedTimeBoxes::const_iterator it = datesBefore.begin(); it != datesBefore.end(); ++it)
     {
-        if (it->first == boxId)
-            continue;
+        TTObject mainProcess = getMainProcess(it->id);
+        TimeValue start, end;
+        
+        mainProcess.get("startDate", v);
+        start = v[0];
         
-        TTObject mainProcess = it->second->object;
-        if (it->second->loop.valid())
-            mainProcess = it->second->loop;
+        mainProcess.get("endDate", v);
+        end = v[0];
         
-        mainProcess.get("container", v);
-        parentScenario = v[0];
+        if (start != it->start || end != it->end)
+            movedBoxes.push_back(MovedTimeBox(it->id, start, end));
         
-        if (parentScenario != nullptr && parentScenario == subScenario)
-            childrenId.push_back(it->first);
+        // a resized box will have to sample its curves again
+        if (end - start != it->end - it->start)
+            invalidateCurveSamples(it->id);
     }
 }
 
 void Engine::uncacheTimeBox(TimeBoxId boxId)
 {
-    EngineCacheElementPtr e = m_timeBoxMap[boxId];
+    EngineCacheElementPtr e = m_timeBoxMap.find(boxId);
+    
+    if (!e) {
+        unknownCacheElement("uncacheTimeBox", boxId);
+        return;
+    }
     
     uncacheStartCallback(boxId);
     uncacheEndCallback(boxId);
+    eraseCurveSamples(boxId);
     
     TTValue out;
     m_iscore.send("ObjectUnregister", e->address, out);
     
-    delete e;
+    // update the hierarchy
+    EngineCacheElementPtr parent = m_timeBoxMap.find(e->parent);
+    if (parent)
+        parent->children.erase(std::remove(parent->children.begin(), parent->children.end(), boxId), parent->children.end());
+    
+    for (std::vector<TimeBoxId>::iterator it = e->children.begin(); it != e->children.end(); ++it) {
+        EngineCacheElementPtr child = m_timeBoxMap.find(*it);
+        if (child)
+            child->parent = NO_ID;
+    }
+    
     m_timeBoxMap.erase(boxId);
 }
 
 void Engine::clearTimeBox()
 {
     EngineCacheMapIterator it;
+    EngineCacheElement  root;
     
     for (it = m_timeBoxMap.begin(); it != m_timeBoxMap.end(); ++it)
     {
         TTValue out;
-        m_iscore.send("ObjectUnregister", it->second->address);
+        m_iscore.send("ObjectUnregister", it->address);
         
         // don't remove the root time process (the main scenario)
-        if (it->first != ROOT_BOX_ID)
+        if (it.id() != ROOT_BOX_ID)
         {
             // get the parent scenario
             TTObject parentScenario;
-            it->second->object.get("container", parentScenario);
+            it->object.get("container", parentScenario);
             
             // release the time process
             TTValue events;
-            events = parentScenario.send("TimeProcessRemove", it->second->object);
+            events = parentScenario.send("TimeProcessRemove", it->object);
             
             // release the sub scenario
-            events = parentScenario.send("TimeProcessRemove", it->second->subScenario);
+            events = parentScenario.send("TimeProcessRemove", it->subScenario);
             
             // release start and end event from the mother scenario
             parentScenario.send("TimeEventRelease", events[0]);
             parentScenario.send("TimeEventRelease", events[1]);
             
-            uncacheStartCallback(it->first);
-            uncacheEndCallback(it->first);
-            delete it->second;
+            uncacheStartCallback(it.id());
+            uncacheEndCallback(it.id());
         }
+        else
+            root = *it;
     }
     
-    // don't clear the m_timeBoxMap (because it is not empty)
+    m_curveSamplesCache.clear();
+    m_recordingCurves.clear();
+    
+    root.children.clear();
+    
     m_startCallbackMap.clear();
     m_endCallbackMap.clear();
     
-    // set the next id to 2 because the main scenario is registered with the 1 id
-    m_nextTimeBoxId = 2;
+    // keep only the main scenario : its id doesn't change
+    m_timeBoxMap.clear();
+    m_timeBoxMap.insertAt(ROOT_BOX_ID, root);
 }
 
-IntervalId Engine::cacheInterval(TTObject& interval)
+IntervalId Engine::cacheInterval(TTObject& interval, TimeBoxId parentId)
 {
-    TimeBoxId id;
-    EngineCacheElementPtr e;
+    EngineCacheElement e;
+    
+    e.object = interval;
+    e.parent = parentId;
     
-    e = new EngineCacheElement();
-    e->object = interval;
+    return m_intervalMap.insert(e);
+}
+
+void Engine::linkInterval(IntervalId relationId, TimeBoxId boxId1, TimeBoxId boxId2)
+{
+    EngineCacheElementPtr e = m_intervalMap.find(relationId);
+    
+    if (!e)
+        return;
     
-    id = m_nextIntervalId;
-    m_intervalMap[id] = e;
-    m_nextIntervalId++;
+    e->relations.push_back(boxId1);
+    e->relations.push_back(boxId2);
     
-    return id;
+    EngineCacheElementPtr box1 = m_timeBoxMap.find(boxId1);
+    EngineCacheElementPtr box2 = m_timeBoxMap.find(boxId2);
+    
+    if (box1)
+        box1->relations.push_back(relationId);
+    
+    if (box2 && box2 != box1)
+        box2->relations.push_back(relationId);
 }
 
 TTObject& Engine::getInterval(IntervalId relationId)
 {
-    return m_intervalMap[relationId]->object;
+    EngineCacheElementPtr e = m_intervalMap.find(relationId);
+    
+    if (!e)
+        return unknownCacheElement("getInterval", relationId).object;
+    
+    return e->object;
 }
 
 void Engine::uncacheInterval(IntervalId relationId)
 {
-    EngineCacheElementPtr e = m_intervalMap[relationId];
+    EngineCacheElementPtr e = m_intervalMap.find(relationId);
+    
+    // unlink the interval from its boxes
+    if (e) {
+        
+        for (std::vector<TimeBoxId>::iterator it = e->relations.begin(); it != e->relations.end(); ++it) {
+            
+            EngineCacheElementPtr box = m_timeBoxMap.find(*it);
+            
+            if (box)
+                box->relations.erase(std::remove(box->relations.begin(), box->relations.end(), relationId), box->relations.end());
+        }
+    }
     
-    delete e;
-    m_intervalMap.erase(relationId);
+    if (!m_intervalMap.erase(relationId))
+        unknownCacheElement("uncacheInterval", relationId);
 }
 
 void Engine::clearInterval()
@@ -464,34 +711,27 @@ void Engine::clearInterval()
     {
         // get the parent scenario
         TTObject parentScenario;
-        it->second->object.get("container", parentScenario);
+        it->object.get("container", parentScenario);
         
         // release the time process
         TTValue events;
-        parentScenario.send("TimeProcessRemove", it->second->object, events);
-        
-        delete it->second;
+        parentScenario.send("TimeProcessRemove", it->object, events);
     }
     
     m_intervalMap.clear();
-    
-    m_nextIntervalId = 1;
 }
 
 ConditionedTimeBoxId Engine::cacheConditionedTimeBox(TimeBoxId boxId, TimeEventIndex controlPointId)
 {
     TTObject                timeProcess = getMainProcess(boxId);
     ConditionedTimeBoxId    id;
-    EngineCacheElementPtr   e;
+    EngineCacheElement      e;
     
     // Create a new engine cache element
-    e = new EngineCacheElement();
-    e->object = timeProcess;
-    e->index = controlPointId;
+    e.object = timeProcess;
+    e.index = controlPointId;
     
-    id = m_nextConditionedTimeBoxId;
-    m_conditionedTimeBoxMap[id] = e;
-    m_nextConditionedTimeBoxId++;
+    id = m_conditionedTimeBoxMap.insert(e);
     
     // We cache an observer on time event status attribute
     cacheStatusCallback(id, controlPointId);
@@ -501,21 +741,32 @@ ConditionedTimeBoxId Engine::cacheConditionedTimeBox(TimeBoxId boxId, TimeEventI
 
 TTObject& Engine::getConditionedTimeProcess(ConditionedTimeBoxId triggerId, TimeEventIndex& controlPointId)
 {
-    controlPointId = m_conditionedTimeBoxMap[triggerId]->index;
+    EngineCacheElementPtr e = m_conditionedTimeBoxMap.find(triggerId);
+    
+    if (!e) {
+        controlPointId = NO_ID;
+        return unknownCacheElement("getConditionedTimeProcess", triggerId).object;
+    }
     
-    return m_conditionedTimeBoxMap[triggerId]->object;
+    controlPointId = e->index;
+    
+    return e->object;
 }
 
 void Engine::uncacheConditionedTimeBox(ConditionedTimeBoxId triggerId)
 {
     // Get the engine cache element
-    EngineCacheElementPtr e = m_conditionedTimeBoxMap[triggerId];
+    EngineCacheElementPtr e = m_conditionedTimeBoxMap.find(triggerId);
+    
+    if (!e) {
+        unknownCacheElement("uncacheConditionedTimeBox", triggerId);
+        return;
+    }
     
     // Uncache observer on time event status attribute
     uncacheStatusCallback(triggerId, e->index);
     
-    // Delete the engine cache element
-    delete e;
+    // Release the engine cache element
     m_conditionedTimeBoxMap.erase(triggerId);
 }
 
@@ -525,33 +776,37 @@ void Engine::clearConditionedTimeBox()
     
     for (it = m_conditionedTimeBoxMap.begin(); it != m_conditionedTimeBoxMap.end(); ++it) {
         
-        uncacheStatusCallback(it->first, it->second->index);
-        
-        delete it->second;
+        // condition ids are also reserved here but they don't observe any time event status
+        if (it->index != NO_ID)
+            uncacheStatusCallback(it.id(), it->index);
     }
     
     m_conditionedTimeBoxMap.clear();
     m_statusCallbackMap.clear();
-    
-    m_nextConditionedTimeBoxId = 1;
+}
+
+TimeConditionId Engine::reserveConditionId()
+{
+    // an element without control point index only reserves the id (because condition and trigger ids are mixed into the timeConditionMap)
+    return m_conditionedTimeBoxMap.insert(EngineCacheElement());
 }
 
 void Engine::cacheTimeCondition(ConditionedTimeBoxId triggerId, TTObject& timeCondition, TTAddress& anAddress)
 {
-    EngineCacheElementPtr   e;
+    EngineCacheElement      e;
     TTValue                 args, out;
     
-    e = new EngineCacheElement();
-    e->object = timeCondition;
-    e->index = triggerId;
-    e->address = anAddress;
+    // note : the element is built before to be stored because timeCondition can refer to an element of the map
+    e.object = timeCondition;
+    e.index = triggerId;
+    e.address = anAddress;
     
-    if (e->address != kTTAdrsEmpty) {
-        args = TTValue(e->address, e->object);
+    if (e.address != kTTAdrsEmpty) {
+        args = TTValue(e.address, e.object);
         m_iscore.send("ObjectRegister", args, out);
     }
     
-    m_timeConditionMap[triggerId] = e;
+    m_timeConditionMap.insertAt(triggerId, e);
     
     // We cache an observer on time condition ready attribute
     cacheReadyCallback(triggerId);
@@ -559,12 +814,22 @@ void Engine::cacheTimeCondition(ConditionedTimeBoxId triggerId, TTObject& timeCo
 
 TTObject& Engine::getTimeCondition(ConditionedTimeBoxId triggerId)
 {
-    return m_timeConditionMap[triggerId]->object;
+    EngineCacheElementPtr e = m_timeConditionMap.find(triggerId);
+    
+    if (!e)
+        return unknownCacheElement("getTimeCondition", triggerId).object;
+    
+    return e->object;
 }
 
 void Engine::uncacheTimeCondition(ConditionedTimeBoxId triggerId)
 {
-    EngineCacheElementPtr   e = m_timeConditionMap[triggerId];
+    EngineCacheElementPtr   e = m_timeConditionMap.find(triggerId);
+    
+    if (!e) {
+        unknownCacheElement("uncacheTimeCondition", triggerId);
+        return;
+    }
     
     TTValue out;
     m_iscore.send("ObjectUnregister", e->address, out);
@@ -572,7 +837,6 @@ void Engine::uncacheTimeCondition(ConditionedTimeBoxId triggerId)
     // Uncache observer on time condition ready attribute
     uncacheReadyCallback(triggerId);
     
-    delete e;
     m_timeConditionMap.erase(triggerId);
 }
 
@@ -583,19 +847,17 @@ void Engine::clearTimeCondition()
     for (it = m_timeConditionMap.begin(); it != m_timeConditionMap.end(); ++it)
     {
         TTValue out;
-        m_iscore.send("ObjectUnregister", it->second->address, out);
+        m_iscore.send("ObjectUnregister", it->address, out);
         
-        uncacheReadyCallback(it->first);
+        uncacheReadyCallback(it.id());
        
         // get the parent scenario
         TTObject parentScenario;
-        it->second->object.get("container", parentScenario);
+        it->object.get("container", parentScenario);
         
         // release the time condition
         TTValue events;
-        parentScenario.send("TimeConditionRelease", it->second->object, events);
-        
-        delete it->second;
+        parentScenario.send("TimeConditionRelease", it->object, events);
     }
     
     m_timeConditionMap.clear();
@@ -604,82 +866,82 @@ void Engine::clearTimeCondition()
 
 void Engine::cacheStartCallback(TimeBoxId boxId)
 {
-    EngineCacheElementPtr   e;
+    EngineCacheElement      e;
     TTValue                 baton;
     
-    e = new EngineCacheElement();
-    e->index = boxId;
+    e.index = boxId;
     
     // create a TTCallback to observe when time process starts (using AutomationStartCallback)
-    e->object = TTObject("callback");
+    e.object = TTObject("callback");
     
     baton = TTValue(TTPtr(this), TTUInt32(boxId));
-    e->object.set("baton", baton);
-    e->object.set("function", TTPtr(&AutomationStartCallback));
-    e->object.set("notification", TTSymbol("ProcessStarted"));
+    e.object.set("baton", baton);
+    e.object.set("function", TTPtr(&AutomationStartCallback));
+    e.object.set("notification", TTSymbol("ProcessStarted"));
     
     // observe the "ProcessStarted" notification
-    getAutomation(boxId).registerObserverForNotifications(e->object);
+    getAutomation(boxId).registerObserverForNotifications(e.object);
 
-    m_startCallbackMap[boxId] = e;
+    m_startCallbackMap.insertAt(boxId, e);
 }
 
 void Engine::uncacheStartCallback(TimeBoxId boxId)
 {
-    EngineCacheElementPtr   e = m_startCallbackMap[boxId];
+    EngineCacheElementPtr   e = m_startCallbackMap.find(boxId);
     TTValue                 v;
     
+    if (!e)
+        return;
+    
     // don't observe the "ProcessStarted" notification anymore
     getAutomation(boxId).unregisterObserverForNotifications(e->object);
     
-    delete e;
     m_startCallbackMap.erase(boxId);
 }
 
 void Engine::cacheEndCallback(TimeBoxId boxId)
 {
-    EngineCacheElementPtr   e;
+    EngineCacheElement      e;
     TTValue                 baton;
     
-    e = new EngineCacheElement();
-    e->index = boxId;
+    e.index = boxId;
     
     // create a TTCallback to observe when time process starts (using AutomationEndCallback)
-    e->object = TTObject("callback");
+    e.object = TTObject("callback");
     
     baton = TTValue(TTPtr(this), TTUInt32(boxId));
-    e->object.set("baton", baton);
-    e->object.set("function", TTPtr(&AutomationEndCallback));
-    e->object.set("notification", TTSymbol("ProcessEnded"));
+    e.object.set("baton", baton);
+    e.object.set("function", TTPtr(&AutomationEndCallback));
+    e.object.set("notification", TTSymbol("ProcessEnded"));
     
     // observe the "ProcessStarted" notification
-    getAutomation(boxId).registerObserverForNotifications(e->object);
+    getAutomation(boxId).registerObserverForNotifications(e.object);
     
-    m_endCallbackMap[boxId] = e;
+    m_endCallbackMap.insertAt(boxId, e);
 }
 
 void Engine::uncacheEndCallback(TimeBoxId boxId)
 {
-    EngineCacheElementPtr   e = m_endCallbackMap[boxId];
+    EngineCacheElementPtr   e = m_endCallbackMap.find(boxId);
     TTValue                 v;
     
+    if (!e)
+        return;
+    
     // don't observe the "ProcessEnded" notification anymore
     getAutomation(boxId).registerObserverForNotifications(e->object);
     
-    delete e;
     m_endCallbackMap.erase(boxId);
 }
 
 void Engine::cacheStatusCallback(ConditionedTimeBoxId triggerId, TimeEventIndex controlPointId)
 {
-    EngineCacheElementPtr   e;
+    EngineCacheElement      e;
     TTObject    timeProcess = getConditionedTimeProcess(triggerId, controlPointId);
     TTObject    timeEvent;
     TTValue     v, baton;
     
-    // Create a new engine cache element
-    e = new EngineCacheElement();
-    e->index = triggerId;
+    e.index = triggerId;
     
     // get start or end time event
     if (controlPointId == BEGIN_CONTROL_POINT_INDEX)
@@ -690,26 +952,29 @@ void Engine::cacheStatusCallback(ConditionedTimeBoxId triggerId, TimeEventIndex
     timeEvent = v[0];
     
     // create a TTCallback to observe time event status attribute (using TimeEventStatusAttributeCallback)
-    e->object = TTObject("callback");
+    e.object = TTObject("callback");
     
     baton = TTValue(TTPtr(this), TTUInt32(triggerId));
-    e->object.set("baton", baton);
-    e->object.set("function", TTPtr(&TimeEventStatusAttributeCallback));
-    e->object.set("notification", TTSymbol("EventStatusChanged"));
+    e.object.set("baton", baton);
+    e.object.set("function", TTPtr(&TimeEventStatusAttributeCallback));
+    e.object.set("notification", TTSymbol("EventStatusChanged"));
     
     // observe the "EventReadyChanged" notification
-    timeEvent.registerObserverForNotifications(e->object);
+    timeEvent.registerObserverForNotifications(e.object);
 
-    m_statusCallbackMap[triggerId] = e;
+    m_statusCallbackMap.insertAt(triggerId, e);
 }
 
 void Engine::uncacheStatusCallback(ConditionedTimeBoxId triggerId, TimeEventIndex controlPointId)
 {
-    EngineCacheElementPtr   e = m_statusCallbackMap[triggerId];
+    EngineCacheElementPtr   e = m_statusCallbackMap.find(triggerId);
     TTObject    timeProcess = getConditionedTimeProcess(triggerId, controlPointId);
     TTObject    timeEvent;
     TTValue     v;
     
+    if (!e)
+        return;
+    
     // get start or end time event
     if (controlPointId == BEGIN_CONTROL_POINT_INDEX)
         timeProcess.get("startEvent", v);
@@ -721,53 +986,55 @@ void Engine::uncacheStatusCallback(ConditionedTimeBoxId triggerId, TimeEventInde
     // don't observe the "EventStatusChanged" notification anymore
     timeEvent.unregisterObserverForNotifications(e->object);
     
-    delete e;
     m_statusCallbackMap.erase(triggerId);
 }
 
 void Engine::cacheReadyCallback(ConditionedTimeBoxId triggerId)
 {
-    EngineCacheElementPtr   e;
+    EngineCacheElement      e;
     TTObject    timeCondition = getTimeCondition(triggerId);
     TTValue     v, baton;
     
-    // Create a new engine cache element
-    e = new EngineCacheElement();
-    e->index = triggerId;
+    e.index = triggerId;
     
     // create a TTCallback to observe time condition ready attribute (using TimeConditionReadyAttributeCallback)
-    e->object = TTObject("callback");
+    e.object = TTObject("callback");
     
     baton = TTValue(TTPtr(this));
-    e->object.set("baton", baton);
-    e->object.set("function", TTPtr(&TimeConditionReadyAttributeCallback));
-    e->object.set("notification", TTSymbol("ConditionReadyChanged"));
+    e.object.set("baton", baton);
+    e.object.set("function", TTPtr(&TimeConditionReadyAttributeCallback));
+    e.object.set("notification", TTSymbol("ConditionReadyChanged"));
     
     // observe the "ConditionReadyChanged" notification
-    timeCondition.registerObserverForNotifications(e->object);
+    timeCondition.registerObserverForNotifications(e.object);
     
-    m_readyCallbackMap[triggerId] = e;
+    m_readyCallbackMap.insertAt(triggerId, e);
 }
 
 void Engine::uncacheReadyCallback(ConditionedTimeBoxId triggerId)
 {
-    EngineCacheElementPtr   e = m_readyCallbackMap[triggerId];
+    EngineCacheElementPtr   e = m_readyCallbackMap.find(triggerId);
     TTObject    timeCondition = getTimeCondition(triggerId);
     
+    if (!e)
+        return;
+    
     // don't observe the "ConditionReadyChanged" notification anymore
     timeCondition.unregisterObserverForNotifications(e->object);
     
-    delete e;
     m_readyCallbackMap.erase(triggerId);
 }
 
 void Engine::appendToCacheReadyCallback(ConditionedTimeBoxId triggerId, ConditionedTimeBoxId triggerIdToAppend)
 {
-    EngineCacheElementPtr   e = m_readyCallbackMap[triggerId];
+    EngineCacheElementPtr   e = m_readyCallbackMap.find(triggerId);
     TTObject    timeCondition = getTimeCondition(triggerId);
     TTValue     baton, newBaton;
     TTBoolean   found = false;
     
+    if (!e)
+        return;
+    
     e->object.get("baton", baton);
     
     newBaton.append(baton[0]);
@@ -787,10 +1054,13 @@ void Engine::appendToCacheReadyCallback(ConditionedTimeBoxId triggerId, Conditio
 
 void Engine::removeFromCacheReadyCallback(ConditionedTimeBoxId triggerId, ConditionedTimeBoxId triggerIdToRemove)
 {
-    EngineCacheElementPtr   e = m_readyCallbackMap[triggerId];
+    EngineCacheElementPtr   e = m_readyCallbackMap.find(triggerId);
     TTObject    timeCondition = getTimeCondition(triggerId);
     TTValue     baton, newBaton;
     
+    if (!e)
+        return;
+    
     e->object.get("baton", baton);
     
     newBaton.append(baton[0]);
@@ -805,7 +1075,13 @@ void Engine::removeFromCacheReadyCallback(ConditionedTimeBoxId triggerId, Condit
 
 TimeBoxId Engine::getNextTimeBoxId()
 {
-    return m_nextTimeBoxId;
+    return m_timeBoxMap.nextId();
+}
+
+unsigned int Engine::getNextTimeBoxNumber()
+{
+    // -1 because the main scenario is at 1 so the first box is at 2
+    return m_timeBoxMap.nextIndex() - 1;
 }
 
 TimeBoxId Engine::addBox(TimeValue boxBeginPos, TimeValue boxLength, const std::string & name, TimeBoxId motherId)
@@ -845,7 +1121,7 @@ TimeBoxId Engine::addBox(TimeValue boxBeginPos, TimeValue boxLength, const std::
     else
         address = getAddress(motherId).appendAddress(TTAddress(name.data()));
     
-    boxId = cacheTimeBox(automation, address, subScenario);
+    boxId = cacheTimeBox(automation, address, subScenario, motherId);
     
     iscoreEngineDebug TTLogMessage("TimeProcess %ld created at %ld ms for a duration of %ld ms\n", boxId, boxBeginPos, boxLength);
     
@@ -860,6 +1136,11 @@ void Engine::removeBox(TimeBoxId boxId)
     TTValue     out;
     TTErr       err;
     
+    if (!isTimeBoxCached(boxId)) {
+        TTLogError("Engine::removeBox : unknown or stale id %ld\n", boxId);
+        return;
+    }
+    
     // if there is a loop : disable it before
     if (isLoop(boxId))
         disableLoop(boxId);
@@ -898,7 +1179,7 @@ IntervalId Engine::addTemporalRelation(TimeBoxId boxId1,
                                        TimeEventIndex controlPoint1,
                                        TimeBoxId boxId2,
                                        TimeEventIndex controlPoint2,
-                                       vector<TimeBoxId>& movedBoxes)
+                                       MovedTimeBoxes& movedBoxes)
 {
     TTObject    interval;
     TTObject    timeProcess1, timeProcess2;
@@ -906,9 +1187,10 @@ IntervalId Engine::addTemporalRelation(TimeBoxId boxId1,
     TTObject    startScenario, endScenario;
     TTObject    endCondition;
     IntervalId  relationId;
+    TimeBoxId   parentId;
     TTValue     args, out;
     TTErr       err;
-    EngineCacheMapIterator  it;
+    MovedTimeBoxes  datesBefore;
     
     // get the events from the given box ids and pass them to the time process
     timeProcess1 = getMainProcess(boxId1);
@@ -938,6 +1220,14 @@ IntervalId Engine::addTemporalRelation(TimeBoxId boxId1,
     // can't create a relation between to events of 2 differents scenarios
     if (startScenario != endScenario)
         return NO_ID;
+    
+    // only the boxes linked to the two boxes can be moved by the new relation
+    parentId = getParentId(boxId1);
+    
+    std::vector<TimeBoxId> boxesId;
+    boxesId.push_back(boxId1);
+    boxesId.push_back(boxId2);
+    snapshotRelatedDates(boxesId, datesBefore);
 
     // create a new interval time process into the main scenario
     args = TTValue(TTSymbol("Interval"), startEvent, endEvent);
@@ -953,13 +1243,11 @@ IntervalId Engine::addTemporalRelation(TimeBoxId boxId1,
         interval.set("rigid", !endCondition.valid());
 
         // cache it and get an unique id for this interval
-        relationId = cacheInterval(interval);
+        relationId = cacheInterval(interval, parentId);
+        linkInterval(relationId, boxId1, boxId2);
     
-        // return the entire time box map except the first box !!! (this is bad but it is like former engine)
-        it = m_timeBoxMap.begin();
-        it++;
-        for (; it != m_timeBoxMap.end(); ++it)
-            movedBoxes.push_back(it->first);
+        // return only the boxes whose dates have changed
+        getMovedBoxes(datesBefore, movedBoxes);
     
         return relationId;
     }
@@ -1001,13 +1289,24 @@ void Engine::removeTemporalRelation(IntervalId relationId)
     uncacheInterval(relationId);
 }
 
-void Engine::changeTemporalRelationBounds(IntervalId relationId, BoundValue minBound, BoundValue maxBound, vector<TimeBoxId>& movedBoxes)
+void Engine::changeTemporalRelationBounds(IntervalId relationId, BoundValue minBound, BoundValue maxBound, MovedTimeBoxes& movedBoxes)
 {
-    TTObject    interval = getInterval(relationId);
+    EngineCacheElementPtr   e = m_intervalMap.find(relationId);
+    TTObject    interval;
     TTUInt32    durationMin;
     TTUInt32    durationMax;
     TTValue     args, out;
-    EngineCacheMapIterator  it;
+    MovedTimeBoxes  datesBefore;
+    
+    if (!e) {
+        TTLogError("Engine::changeTemporalRelationBounds : unknown or stale id %ld\n", relationId);
+        return;
+    }
+    
+    interval = e->object;
+    
+    // only the boxes linked to the relation can be moved by the new bounds
+    snapshotRelatedDates(e->relations, datesBefore);
 
     // filtering NO_BOUND (-1) and negative value because we use unsigned int
     if (minBound == NO_BOUND)
@@ -1029,11 +1328,8 @@ void Engine::changeTemporalRelationBounds(IntervalId relationId, BoundValue minB
     args = TTValue(durationMin, durationMax);
     interval.send("Limit", args, out);
     
-    // return the entire time box map except the first box !!! (this is bad but it is like former engine)
-    it = m_timeBoxMap.begin();
-    it++;
-    for (; it != m_timeBoxMap.end(); ++it)
-        movedBoxes.push_back(it->first);
+    // return only the boxes whose dates have changed
+    getMovedBoxes(datesBefore, movedBoxes);
 }
 
 bool Engine::isTemporalRelationExisting(TimeBoxId boxId1, TimeEventIndex controlPoint1, TimeBoxId boxId2, TimeEventIndex controlPoint2)
@@ -1056,14 +1352,14 @@ bool Engine::isTemporalRelationExisting(TimeBoxId boxId1, TimeEventIndex control
     // Look into the interval map to retreive an interval with the same events
     for (it = m_intervalMap.begin(); it != m_intervalMap.end(); ++it) {
         
-        it->second->object.get("startEvent", v);
+        it->object.get("startEvent", v);
         
         if (v == v1) {
             
-            it->second->object.get("endEvent", v);
+            it->object.get("endEvent", v);
             
             if (v == v2) {
-                found = it->first;
+                found = it.id();
                 break;
             }
         }
@@ -1084,21 +1380,21 @@ TimeBoxId Engine::getRelationFirstBoxId(IntervalId relationId)
     // Look into the time box map to retreive an automation with the same event
     for (it = m_timeBoxMap.begin(); it != m_timeBoxMap.end(); ++it)
     {
-        TTObject mainProcess = it->second->object;
-        if (it->second->loop.valid())
-            mainProcess = it->second->loop;
+        TTObject mainProcess = it->object;
+        if (it->loop.valid())
+            mainProcess = it->loop;
         
         mainProcess.get("startEvent", v);
         
         if (out == v) {
-            found = it->first;
+            found = it.id();
             break;
         }
         
         mainProcess.get("endEvent", v);
         
         if (out == v) {
-            found = it->first;
+            found = it.id();
             break;
         }
     }
@@ -1118,9 +1414,9 @@ TimeEventIndex Engine::getRelationFirstCtrlPointIndex(IntervalId relationId)
     // Look into the time box map to retreive an automation with the same event
     for (it = m_timeBoxMap.begin(); it != m_timeBoxMap.end(); ++it)
     {
-        TTObject mainProcess = it->second->object;
-        if (it->second->loop.valid())
-            mainProcess = it->second->loop;
+        TTObject mainProcess = it->object;
+        if (it->loop.valid())
+            mainProcess = it->loop;
         
         mainProcess.get("startEvent", v);
         
@@ -1152,21 +1448,21 @@ TimeBoxId Engine::getRelationSecondBoxId(IntervalId relationId)
     // Look into the time box map to retreive an automation with the same event
     for (it = m_timeBoxMap.begin(); it != m_timeBoxMap.end(); ++it)
     {
-        TTObject mainProcess = it->second->object;
-        if (it->second->loop.valid())
-            mainProcess = it->second->loop;
+        TTObject mainProcess = it->object;
+        if (it->loop.valid())
+            mainProcess = it->loop;
         
         mainProcess.get("startEvent", v);
         
         if (out == v) {
-            found = it->first;
+            found = it.id();
             break;
         }
         
         mainProcess.get("endEvent", v);
         
         if (out == v) {
-            found = it->first;
+            found = it.id();
             break;
         }
     }
@@ -1186,9 +1482,9 @@ TimeEventIndex Engine::getRelationSecondCtrlPointIndex(IntervalId relationId)
     // Look into the time box map to retreive an automation with the same event
     for (it = m_timeBoxMap.begin(); it != m_timeBoxMap.end(); ++it)
     {
-        TTObject mainProcess = it->second->object;
-        if (it->second->loop.valid())
-            mainProcess = it->second->loop;
+        TTObject mainProcess = it->object;
+        if (it->loop.valid())
+            mainProcess = it->loop;
         
         mainProcess.get("startEvent", v);
         
@@ -1226,24 +1522,97 @@ BoundValue Engine::getRelationMaxBound(IntervalId relationId)
     return v[0];
 }
 
-bool Engine::performBoxEditing(TimeBoxId boxId, TimeValue start, TimeValue end, vector<TimeBoxId>& movedBoxes)
+bool Engine::performBoxEditing(TimeBoxId boxId, TimeValue start, TimeValue end, MovedTimeBoxes& movedBoxes)
 {
     TTValue args, out;
     TTErr   err;
-    EngineCacheMapIterator  it;
+    MovedTimeBoxes  datesBefore;
+    
+    if (!isTimeBoxCached(boxId)) {
+        TTLogError("Engine::performBoxEditing : unknown or stale id %ld\n", boxId);
+        return false;
+    }
+    
+    // during an edition the move is applied by commitEdit
+    if (m_editing) {
+        m_pendingMoves[boxId] = std::make_pair(start, end);
+        return true;
+    }
+    
+    // the move is solved through the temporal relations : only the boxes linked to this one can be moved
+    snapshotRelatedDates(std::vector<TimeBoxId>(1, boxId), datesBefore);
     
     args = TTValue(start, end);
     err = getMainProcess(boxId).send("Move", args, out);
 
-    // return the entire time box map except the first box !!! (this is bad but it is like former engine)
-    it = m_timeBoxMap.begin();
-    it++;
-    for (; it != m_timeBoxMap.end(); ++it)
-        movedBoxes.push_back(it->first);
+    // return only the boxes whose dates have changed
+    getMovedBoxes(datesBefore, movedBoxes);
     
     return !err;
 }
 
+void Engine::beginEdit()
+{
+    if (m_editing)
+        iscoreEngineDebug TTLogMessage("Engine::beginEdit : an edition is already started\n");
+    
+    m_editing = true;
+    m_pendingMoves.clear();
+}
+
+bool Engine::commitEdit(MovedTimeBoxes& movedBoxes, vector<TimeBoxId>& refusedBoxes)
+{
+    std::map<TimeBoxId, std::pair<TimeValue, TimeValue>>::iterator it;
+    std::vector<TimeBoxId> editedBoxesId;
+    MovedTimeBoxes  datesBefore;
+    TTValue         args, out, v;
+    TTErr           err;
+    
+    m_editing = false;
+    
+    // snapshot the dates of the boxes linked to the edited ones once
+    for (it = m_pendingMoves.begin(); it != m_pendingMoves.end(); ++it)
+        editedBoxesId.push_back(it->first);
+    
+    snapshotRelatedDates(editedBoxesId, datesBefore);
+    
+    // apply the moves
+    for (it = m_pendingMoves.begin(); it != m_pendingMoves.end(); ++it)
+    {
+        TTObject mainProcess;
+        TimeValue start, end;
+        
+        // the box could have been removed during the edition
+        if (!isTimeBoxCached(it->first))
+            continue;
+        
+        mainProcess = getMainProcess(it->first);
+        
+        // the box could have been already moved by a former move
+        mainProcess.get("startDate", v);
+        start = v[0];
+        
+        mainProcess.get("endDate", v);
+        end = v[0];
+        
+        if (start == it->second.first && end == it->second.second)
+            continue;
+        
+        args = TTValue(it->second.first, it->second.second);
+        err = mainProcess.send("Move", args, out);
+        
+        if (err)
+            refusedBoxes.push_back(it->first);
+    }
+    
+    m_pendingMoves.clear();
+    
+    // return only the boxes whose dates have changed
+    getMovedBoxes(datesBefore, movedBoxes);
+    
+    return refusedBoxes.empty();
+}
+
 std::string Engine::getBoxName(TimeBoxId boxId)
 {
     TTSymbol    name;
@@ -1354,6 +1723,9 @@ TimeValue Engine::getBoxBeginTime(TimeBoxId boxId)
     TTValue     v;
     TimeValue   startDate;
 
+    if (!isTimeBoxCached(boxId))
+        return 0;
+    
 	getMainProcess(boxId).get("startDate", v);
     startDate = v[0];
     
@@ -1365,6 +1737,9 @@ TimeValue Engine::getBoxEndTime(TimeBoxId boxId)
     TTValue     v;
     TimeValue   endDate;
 
+    if (!isTimeBoxCached(boxId))
+        return 0;
+    
 	getMainProcess(boxId).get("endDate", v);
     endDate = v[0];
     
@@ -1401,21 +1776,10 @@ TimeEventIndex Engine::getBoxLastCtrlPointIndex(TimeBoxId /*boxId*/)
 
 void Engine::setCtrlPointMessagesToSend(TimeBoxId boxId, TimeEventIndex controlPointIndex, std::vector<std::string> messageToSend, bool /*muteState*/)
 {
-    TTValue     out;
-    TTObject    event;
-    TTObject    state;
+    StateLines  state;
     TTUInt32    i;
-
-    // get the start or end event
-    if (controlPointIndex == BEGIN_CONTROL_POINT_INDEX)
-        getMainProcess(boxId).get("startEvent", out);
-    else
-        getMainProcess(boxId).get("endEvent", out);
-    
-    event = out[0];
     
-    // clear the state of the event
-    event.send("StateClear");
+    state.reserve(messageToSend.size());
     
     // parse each incoming string into < directory:/address, value >
     for (i = 0; i < messageToSend.size(); i++)
@@ -1423,61 +1787,47 @@ void Engine::setCtrlPointMessagesToSend(TimeBoxId boxId, TimeEventIndex controlP
         TTValue v = TTString(messageToSend[i]);
         v.fromString();
         
+        if (v.size() == 0)
+            continue;
+        
         TTSymbol aSymbol = v[0];
-		TTAddress anAddress = toTTAddress(aSymbol.string().data());
-        v[0] = anAddress;
+        StateLine line(AddressTable::getInstance().intern(aSymbol.string().data()));
         
-        // append a line to the state
-        event.send("StateAddressSetValue", v);
+        line.value.copyFrom(v, 1);
+        
+        state.push_back(line);
     }
     
-    // don't update curve for the root box because it is a Scenario and not an Automation
-    if (boxId != ROOT_BOX_ID) {
-    
-        // update all curves
-        getAutomation(boxId).send("CurveUpdate");
-    }
+    setCtrlPointState(boxId, controlPointIndex, state);
 }
 
 void Engine::getCtrlPointMessagesToSend(TimeBoxId boxId, TimeEventIndex controlPointIndex, std::vector<std::string>& messages)
 {
-    TTValue     out;
-    TTObject    event;
-    TTAddress   address;
+    StateLines  state;
     std::string s;
     
-    // get the start or end event
-    if (controlPointIndex == BEGIN_CONTROL_POINT_INDEX)
-        getMainProcess(boxId).get("startEvent", out);
-    else
-        getMainProcess(boxId).get("endEvent", out);
-    
-    event = out[0];
+    getCtrlPointState(boxId, controlPointIndex, state);
     
-    // get all addresses of the state of the event and their value
-    TTValue none, addresses;
-    addresses = event.send("StateAddresses", none);
+    messages.reserve(messages.size() + state.size());
     
-    for (TTElementIter it = addresses.begin(); it != addresses.end(); it++)
+    for (StateLines::iterator it = state.begin(); it != state.end(); it++)
     {
-        TTAddress address = TTElement(*it);
-        TTValue value = event.send("StateAddressGetValue", address);
-        
-        value.toString();
+        it->value.toString();
         
         // edit string
-        s = toNetworkTreeAddress(address);
+        s = AddressTable::getInstance().address(it->address);
         s += " ";
-        s += TTString(value[0]).c_str();
+        s += TTString(it->value[0]).c_str();
         
         messages.push_back(s);
     }
 }
 
-void Engine::setCtrlPointMutingState(TimeBoxId boxId, TimeEventIndex controlPointIndex, bool mute)
+void Engine::setCtrlPointState(TimeBoxId boxId, TimeEventIndex controlPointIndex, const StateLines& state)
 {
     TTValue     out;
     TTObject    event;
+    TTUInt32    i, j;
     
     // get the start or end event
     if (controlPointIndex == BEGIN_CONTROL_POINT_INDEX)
@@ -1487,9 +1837,78 @@ void Engine::setCtrlPointMutingState(TimeBoxId boxId, TimeEventIndex controlPoin
     
     event = out[0];
     
-    event.set("mute", mute);
-}
-
+    // clear the state of the event
+    event.send("StateClear");
+    
+    // append each line to the state as < directory:/address, value >
+    for (i = 0; i < state.size(); i++)
+    {
+        const StateLine& line = state[i];
+        TTValue v;
+        
+        v.resize(line.value.size() + 1);
+        v[0] = AddressTable::getInstance().ttAddress(line.address);
+        
+        for (j = 0; j < line.value.size(); j++)
+            v[j + 1] = line.value[j];
+        
+        event.send("StateAddressSetValue", v);
+    }
+    
+    // don't update curve for the root box because it is a Scenario and not an Automation
+    if (boxId != ROOT_BOX_ID) {
+    
+        // the start or end values of the curves may have changed
+        invalidateCurveSamples(boxId);
+        
+        // update all curves
+        getAutomation(boxId).send("CurveUpdate");
+    }
+}
+
+void Engine::getCtrlPointState(TimeBoxId boxId, TimeEventIndex controlPointIndex, StateLines& state)
+{
+    TTValue     out;
+    TTObject    event;
+    
+    // get the start or end event
+    if (controlPointIndex == BEGIN_CONTROL_POINT_INDEX)
+        getMainProcess(boxId).get("startEvent", out);
+    else
+        getMainProcess(boxId).get("endEvent", out);
+    
+    event = out[0];
+    
+    // get all addresses of the state of the event and their value
+    TTValue none, addresses;
+    addresses = event.send("StateAddresses", none);
+    
+    state.reserve(state.size() + addresses.size());
+    
+    for (TTElementIter it = addresses.begin(); it != addresses.end(); it++)
+    {
+        TTAddress address = TTElement(*it);
+        
+        state.push_back(StateLine(AddressTable::getInstance().intern(address), event.send("StateAddressGetValue", address)));
+    }
+}
+
+void Engine::setCtrlPointMutingState(TimeBoxId boxId, TimeEventIndex controlPointIndex, bool mute)
+{
+    TTValue     out;
+    TTObject    event;
+    
+    // get the start or end event
+    if (controlPointIndex == BEGIN_CONTROL_POINT_INDEX)
+        getMainProcess(boxId).get("startEvent", out);
+    else
+        getMainProcess(boxId).get("endEvent", out);
+    
+    event = out[0];
+    
+    event.set("mute", mute);
+}
+
 bool Engine::getCtrlPointMutingState(TimeBoxId boxId, TimeEventIndex controlPointIndex)
 {
     TTValue     out;
@@ -1511,23 +1930,37 @@ bool Engine::getCtrlPointMutingState(TimeBoxId boxId, TimeEventIndex controlPoin
 //CURVES ////////////////////////////////////////////////////////////////////////////////////
 
 void Engine::addCurve(TimeBoxId boxId, const std::string & address)
+{
+    addCurve(boxId, AddressTable::getInstance().intern(address));
+}
+
+void Engine::addCurve(TimeBoxId boxId, AddressId addressId)
 {
     TTValue out;
     
     // add the curve addresses into the automation time process
-    getAutomation(boxId).send("CurveAdd", toTTAddress(address), out);
+    getAutomation(boxId).send("CurveAdd", AddressTable::getInstance().ttAddress(addressId), out);
 }
 
 void Engine::removeCurve(TimeBoxId boxId, const std::string & address)
+{
+    removeCurve(boxId, AddressTable::getInstance().intern(address));
+}
+
+void Engine::removeCurve(TimeBoxId boxId, AddressId addressId)
 {
     TTValue out;
     
+    invalidateCurveSamples(boxId, addressId);
+    
     // remove the curve addresses of the automation time process
-    getAutomation(boxId).send("CurveRemove", toTTAddress(address), out);
+    getAutomation(boxId).send("CurveRemove", AddressTable::getInstance().ttAddress(addressId), out);
 }
 
 void Engine::clearCurves(TimeBoxId boxId)
 {
+    invalidateCurveSamples(boxId);
+    
     // clear all the curves of the automation time process
     getAutomation(boxId).send("Clear");
 }
@@ -1547,15 +1980,38 @@ std::vector<std::string> Engine::getCurvesAddress(TimeBoxId boxId)
 	return curveAddresses;
 }
 
+void Engine::getCurvesAddress(TimeBoxId boxId, std::vector<AddressId>& curveAddresses)
+{
+    AddressTable&   table = AddressTable::getInstance();
+    TTValue         out;
+    
+    // get the curve addresses of the automation time process
+    getAutomation(boxId).get("curveAddresses", out);
+    
+    // intern the addresses into the vector
+    for (TTUInt32 i = 0; i < out.size(); i++) {
+        
+        TTAddress address = out[i];
+        curveAddresses.push_back(table.intern(address));
+    }
+}
+
 void Engine::setCurveSampleRate(TimeBoxId boxId, const std::string & address, unsigned int nbSamplesBySec)
+{
+    setCurveSampleRate(boxId, AddressTable::getInstance().intern(address), nbSamplesBySec);
+}
+
+void Engine::setCurveSampleRate(TimeBoxId boxId, AddressId addressId, unsigned int nbSamplesBySec)
 {
     TTObject    curve;
     TTValue     objects;
     TTUInt32    i;
     TTErr       err;
     
+    invalidateCurveSamples(boxId, addressId);
+    
     // get curve object at address
-    err = getAutomation(boxId).send("CurveGet", toTTAddress(address), objects);
+    err = getAutomation(boxId).send("CurveGet", AddressTable::getInstance().ttAddress(addressId), objects);
     
     if (!err) {
         
@@ -1570,13 +2026,18 @@ void Engine::setCurveSampleRate(TimeBoxId boxId, const std::string & address, un
 }
 
 unsigned int Engine::getCurveSampleRate(TimeBoxId boxId, const std::string & address)
+{
+    return getCurveSampleRate(boxId, AddressTable::getInstance().intern(address));
+}
+
+unsigned int Engine::getCurveSampleRate(TimeBoxId boxId, AddressId addressId)
 {
     TTObject    curve;
     TTValue     out, objects;
     TTErr       err;
     
     // get curve object at address
-    err = getAutomation(boxId).send("CurveGet", toTTAddress(address), objects);
+    err = getAutomation(boxId).send("CurveGet", AddressTable::getInstance().ttAddress(addressId), objects);
     
     if (!err) {
         
@@ -1591,6 +2052,11 @@ unsigned int Engine::getCurveSampleRate(TimeBoxId boxId, const std::string & add
 }
 
 void Engine::setCurveRedundancy(TimeBoxId boxId, const std::string & address, bool redundancy)
+{
+    setCurveRedundancy(boxId, AddressTable::getInstance().intern(address), redundancy);
+}
+
+void Engine::setCurveRedundancy(TimeBoxId boxId, AddressId addressId, bool redundancy)
 {
     TTObject    curve;
     TTValue     objects;
@@ -1598,7 +2064,7 @@ void Engine::setCurveRedundancy(TimeBoxId boxId, const std::string & address, bo
     TTErr       err;
     
     // get curve object at address
-    err = getAutomation(boxId).send("CurveGet", toTTAddress(address), objects);
+    err = getAutomation(boxId).send("CurveGet", AddressTable::getInstance().ttAddress(addressId), objects);
     
     if (!err) {
         
@@ -1613,13 +2079,18 @@ void Engine::setCurveRedundancy(TimeBoxId boxId, const std::string & address, bo
 }
 
 bool Engine::getCurveRedundancy(TimeBoxId boxId, const std::string & address)
+{
+    return getCurveRedundancy(boxId, AddressTable::getInstance().intern(address));
+}
+
+bool Engine::getCurveRedundancy(TimeBoxId boxId, AddressId addressId)
 {
     TTObject    curve;
     TTValue     out, objects;
     TTErr       err;
     
     // get curve object at address
-    err = getAutomation(boxId).send("CurveGet", toTTAddress(address), objects);
+    err = getAutomation(boxId).send("CurveGet", AddressTable::getInstance().ttAddress(addressId), objects);
     
     if (!err) {
         
@@ -1635,6 +2106,11 @@ bool Engine::getCurveRedundancy(TimeBoxId boxId, const std::string & address)
 }
 
 void Engine::setCurveMuteState(TimeBoxId boxId, const std::string & address, bool muteState)
+{
+    setCurveMuteState(boxId, AddressTable::getInstance().intern(address), muteState);
+}
+
+void Engine::setCurveMuteState(TimeBoxId boxId, AddressId addressId, bool muteState)
 {
     TTObject    curve;
     TTValue     objects;
@@ -1642,7 +2118,7 @@ void Engine::setCurveMuteState(TimeBoxId boxId, const std::string & address, boo
     TTErr       err;
     
     // get curve object at address
-    err = getAutomation(boxId).send("CurveGet", toTTAddress(address), objects);
+    err = getAutomation(boxId).send("CurveGet", AddressTable::getInstance().ttAddress(addressId), objects);
     
     if (!err) {
         
@@ -1657,13 +2133,18 @@ void Engine::setCurveMuteState(TimeBoxId boxId, const std::string & address, boo
 }
 
 bool Engine::getCurveMuteState(TimeBoxId boxId, const std::string & address)
+{
+    return getCurveMuteState(boxId, AddressTable::getInstance().intern(address));
+}
+
+bool Engine::getCurveMuteState(TimeBoxId boxId, AddressId addressId)
 {
     TTObject    curve;
     TTValue     out, objects;
     TTErr       err;
     
     // get curve object at address
-    err = getAutomation(boxId).send("CurveGet", toTTAddress(address), objects);
+    err = getAutomation(boxId).send("CurveGet", AddressTable::getInstance().ttAddress(addressId), objects);
     
     if (!err) {
         
@@ -1679,39 +2160,58 @@ bool Engine::getCurveMuteState(TimeBoxId boxId, const std::string & address)
 }
 
 void Engine::setCurveRecording(TimeBoxId boxId, const std::string & address, bool record)
+{
+    setCurveRecording(boxId, AddressTable::getInstance().intern(address), record);
+}
+
+void Engine::setCurveRecording(TimeBoxId boxId, AddressId addressId, bool record)
 {
     TTValue args, out;
     
     // enable/disable recording
-    args = TTValue(toTTAddress(address), record);
+    args = TTValue(AddressTable::getInstance().ttAddress(addressId), record);
     
     getAutomation(boxId).send("CurveRecord", args, out);
+    
+    // a recorded curve is changed by its automation without the Engine knowing it
+    if (record)
+        m_recordingCurves.insert(std::make_pair(boxId, addressId));
+    else
+        m_recordingCurves.erase(std::make_pair(boxId, addressId));
+    
+    invalidateCurveSamples(boxId, addressId);
+}
+
+bool Engine::setCurveSections(TimeBoxId boxId, std::string address, unsigned int argNb, const std::vector<float> & percent, const std::vector<float> & y, const std::vector<short> & sectionType, const std::vector<float> & coeff)
+{
+    return setCurveSections(boxId, AddressTable::getInstance().intern(address), argNb, percent, y, sectionType, coeff);
 }
 
-bool Engine::setCurveSections(TimeBoxId boxId, std::string address, unsigned int /*argNb*/, const std::vector<float> & percent, const std::vector<float> & y, const std::vector<short> & /*sectionType*/, const std::vector<float> & coeff)
+bool Engine::setCurveSections(TimeBoxId boxId, AddressId addressId, unsigned int /*argNb*/, const std::vector<float> & percent, const std::vector<float> & y, const std::vector<short> & /*sectionType*/, const std::vector<float> & coeff)
 {
     TTObject    curve;
     TTValue     parameters, objects;
-    TTUInt32    i, nbPoints = coeff.size();
+    CurvePoints points;
+    TTUInt32    i;
     TTErr       err;
     
+    invalidateCurveSamples(boxId, addressId);
+    
     // get curve object at address
-    err = getAutomation(boxId).send("CurveGet", toTTAddress(address), objects);
+    err = getAutomation(boxId).send("CurveGet", AddressTable::getInstance().ttAddress(addressId), objects);
     
     if (!err) {
         
+        sectionsToCurvePoints(percent, y, coeff, points);
+        
         // edit parameters as : x1 y1 b1 x2 y2 b2
-        parameters.resize(nbPoints * 3);
+        parameters.resize(points.size() * 3);
         
         for (i = 0; i < parameters.size(); i = i+3) {
             
-            parameters[i] = TTFloat64(percent[i/3] / 100.);
-            parameters[i+1] = TTFloat64(y[i/3]);
-            
-            // from the second point
-            TTFloat64 c = coeff[i/3];
-            
-            parameters[i+2] = c * c * c * c;
+            parameters[i] = TTFloat64(points[i/3].x);
+            parameters[i+1] = TTFloat64(points[i/3].y);
+            parameters[i+2] = TTFloat64(points[i/3].power);
         }
         
         // set first indexed curve only
@@ -1724,7 +2224,13 @@ bool Engine::setCurveSections(TimeBoxId boxId, std::string address, unsigned int
     return err == kTTErrNone;
 }
 
-bool Engine::getCurveSections(TimeBoxId boxId, std::string address, unsigned int /*argNb*/,
+bool Engine::getCurveSections(TimeBoxId boxId, std::string address, unsigned int argNb,
+                              std::vector<float> & percent,  std::vector<float> & y,  std::vector<short> & sectionType,  std::vector<float> & coeff)
+{
+    return getCurveSections(boxId, AddressTable::getInstance().intern(address), argNb, percent, y, sectionType, coeff);
+}
+
+bool Engine::getCurveSections(TimeBoxId boxId, AddressId addressId, unsigned int /*argNb*/,
                               std::vector<float> & percent,  std::vector<float> & y,  std::vector<short> & sectionType,  std::vector<float> & coeff)
 {
     TTObject    curve;
@@ -1733,7 +2239,7 @@ bool Engine::getCurveSections(TimeBoxId boxId, std::string address, unsigned int
     TTErr       err;
     
     // get curve object at address
-    err = getAutomation(boxId).send("CurveGet", toTTAddress(address), objects);
+    err = getAutomation(boxId).send("CurveGet", AddressTable::getInstance().ttAddress(addressId), objects);
     
     if (!err) {
         
@@ -1759,32 +2265,212 @@ bool Engine::getCurveSections(TimeBoxId boxId, std::string address, unsigned int
     return err == kTTErrNone;
 }
 
-bool Engine::getCurveValues(TimeBoxId boxId, const std::string & address, unsigned int /*argNb*/, std::vector<float>& result)
+bool Engine::getCurveValues(TimeBoxId boxId, const std::string & address, unsigned int argNb, std::vector<float>& result)
+{
+    return getCurveValues(boxId, AddressTable::getInstance().intern(address), argNb, result);
+}
+
+bool Engine::getCurveValues(TimeBoxId boxId, AddressId addressId, unsigned int argNb, std::vector<float>& result)
+{
+    CurveSamples samples;
+    
+    if (!getCurveValues(boxId, addressId, argNb, samples))
+        return false;
+    
+    // copy the samples into the result vector
+    result.insert(result.end(), samples->begin(), samples->end());
+    
+	return true;
+}
+
+bool Engine::getCurveValues(TimeBoxId boxId, AddressId addressId, unsigned int /*argNb*/, CurveSamples& result)
+{
+    EngineCacheElementPtr   box = m_timeBoxMap.find(boxId);
+    TTObject    curve;
+    TTValue     out, duration, parameters, sampleRate, curveValues;
+    TTErr       err;
+    
+    if (!box)
+        return false;
+    
+    std::pair<TimeBoxId, AddressId> key = std::make_pair(boxId, addressId);
+    CurveSamplesCacheElement& cached = m_curveSamplesCache[key];
+    
+    // nothing changed the curves of the box since the last sampling
+    if (cached.samples && cached.edit == box->curveEdits) {
+        
+        result = cached.samples;
+        return true;
+    }
+    
+    // get curve object at address
+    err = getAutomation(boxId).send("CurveGet", AddressTable::getInstance().ttAddress(addressId), out);
+    
+    if (err) {
+        
+        invalidateCurveSamples(boxId, addressId);
+        return false;
+    }
+    
+    // get first indexed curve only
+    curve = out[0];
+    
+    // get time process duration and what the sampling depends on
+    getAutomation(boxId).get("duration", duration);
+    curve.get("functionParameters", parameters);
+    curve.get("sampleRate", sampleRate);
+    
+    std::shared_ptr<std::vector<float> > samples = std::make_shared<std::vector<float> >();
+    CurvePoints points;
+    bool        native = m_curveSamplerChecks >= 0 && toCurvePoints(parameters, points);
+    
+    // sample the power sections natively
+    if (native) {
+        
+        samples->resize(curveSamplesCount(TTUInt32(duration[0]), TTUInt32(sampleRate[0])));
+        CurveSampler::sample(points, samples->data(), samples->size());
+    }
+    
+    // let the curve sample itself until the CurveSampler has been checked against it
+    if (!native || !isCurveSamplerChecked()) {
+        
+        err = curve.send("Sample", duration, curveValues);
+        
+        if (err) {
+            
+            invalidateCurveSamples(boxId, addressId);
+            return false;
+        }
+        
+        if (native)
+            checkCurveSampler(points, *samples, curveValues);
+        
+        // copy the curveValues into the shared samples
+        samples->clear();
+        samples->reserve(curveValues.size());
+        
+        for (TTUInt32 i = 0; i < curveValues.size(); i++)
+            samples->push_back(TTFloat64(curveValues[i]));
+    }
+    
+    result = samples;
+    
+    if (m_recordingCurves.count(key))
+        invalidateCurveSamples(boxId, addressId);
+    else {
+        
+        cached.edit = box->curveEdits;
+        cached.samples = samples;
+    }
+    
+	return true;
+}
+
+bool Engine::sampleCurve(TimeBoxId boxId, AddressId addressId, unsigned int nbSamples, std::vector<float>& result)
 {
     TTObject    curve;
-    TTValue     out, duration, curveValues;
+    TTValue     out, parameters;
+    CurvePoints points;
     TTErr       err;
     
     // get curve object at address
-    err = getAutomation(boxId).send("CurveGet", toTTAddress(address), out);
+    err = getAutomation(boxId).send("CurveGet", AddressTable::getInstance().ttAddress(addressId), out);
+    
+    if (err)
+        return false;
+    
+    // get first indexed curve only
+    curve = out[0];
+    curve.get("functionParameters", parameters);
+    
+    if (m_curveSamplerChecks < 0 || !toCurvePoints(parameters, points))
+        return false;
+    
+    result.resize(nbSamples);
+    
+    return CurveSampler::sample(points, result.data(), nbSamples);
+}
 
-    if (!err) {
+bool Engine::isCurveSamplerChecked()
+{
+    return m_curveSamplerChecks >= CURVE_SAMPLER_CHECKS && m_curveSamplerPowerChecked;
+}
+
+bool Engine::sampleCurveSections(const std::vector<float>& percent, const std::vector<float>& y, const std::vector<float>& coeff, unsigned int nbSamples, std::vector<float>& result)
+{
+    CurvePoints points;
+    
+    // the Jamoma curves could sample the sections in another way
+    if (!isCurveSamplerChecked())
+        return false;
+    
+    sectionsToCurvePoints(percent, y, coeff, points);
+    result.resize(nbSamples);
+    
+    return CurveSampler::sample(points, result.data(), nbSamples);
+}
+
+bool Engine::checkCurveSampler(const CurvePoints& points, const std::vector<float>& samples, const TTValue& curveValues)
+{
+    float       low = points.front().y, high = points.front().y, error = 0.;
+    TTUInt32    i;
+    
+    if (samples.size() != curveValues.size()) {
         
-        // get first indexed curve only
-        curve = out[0];
+        TTLogMessage("Engine::checkCurveSampler : %ld values instead of %ld : the curves are sampled by Jamoma\n", long(samples.size()), long(curveValues.size()));
+        m_curveSamplerChecks = -1;
+        return false;
+    }
+    
+    for (CurvePoints::const_iterator it = points.begin(); it != points.end(); it++) {
         
-        // get time process duration
-        getAutomation(boxId).get("duration", duration);
+        low = std::min(low, it->y);
+        high = std::max(high, it->y);
+    }
     
-        // sample the curve
-        err = curve.send("Sample", duration, curveValues);
+    // the end points are compared with the others
+    for (i = 0; i < curveValues.size(); i++)
+        error = std::max(error, float(fabs(samples[i] - TTFloat64(curveValues[i]))));
     
-        // copy the curveValues into the result vector
-        for (TTUInt32 i = 0; i < curveValues.size(); i++)
-            result.push_back(TTFloat64(curveValues[i]));
+    if (error > CURVE_SAMPLER_TOLERANCE * std::max(1.f, high - low)) {
+        
+        TTLogMessage("Engine::checkCurveSampler : a difference of %f : the curves are sampled by Jamoma\n", error);
+        m_curveSamplerChecks = -1;
+        return false;
     }
     
-	return err == kTTErrNone;
+    for (CurvePoints::const_iterator it = points.begin() + 1; it != points.end(); it++)
+        if (it->power != 1.)
+            m_curveSamplerPowerChecked = true;
+    
+    m_curveSamplerChecks++;
+    
+    if (isCurveSamplerChecked())
+        TTLogMessage("Engine::checkCurveSampler : the curves are sampled by the CurveSampler (%s)\n", CurveSampler::instructionSet());
+    
+    return true;
+}
+
+void Engine::invalidateCurveSamples(TimeBoxId boxId)
+{
+    EngineCacheElementPtr e = m_timeBoxMap.find(boxId);
+    
+    // the samples of the box are sampled again at their next access
+    if (e)
+        e->curveEdits++;
+}
+
+void Engine::eraseCurveSamples(TimeBoxId boxId)
+{
+    CurveSamplesCacheMap::iterator it = m_curveSamplesCache.lower_bound(std::make_pair(boxId, AddressId(NO_ADDRESS_ID)));
+    
+    while (it != m_curveSamplesCache.end() && it->first.first == boxId)
+        m_curveSamplesCache.erase(it++);
+}
+
+void Engine::invalidateCurveSamples(TimeBoxId boxId, AddressId addressId)
+{
+    m_curveSamplesCache.erase(std::make_pair(boxId, addressId));
 }
 
 ConditionedTimeBoxId Engine::addTriggerPoint(TimeBoxId boxId, TimeEventIndex controlPointIndex)
@@ -1844,7 +2530,7 @@ ConditionedTimeBoxId Engine::addTriggerPoint(TimeBoxId boxId, TimeEventIndex con
 void Engine::removeTriggerPoint(ConditionedTimeBoxId triggerId)
 {
     // check existence before because they could have been destroyed in deleteCondition
-    if (m_conditionedTimeBoxMap.find(triggerId) == m_conditionedTimeBoxMap.end())
+    if (!m_conditionedTimeBoxMap.contains(triggerId))
         return;
     
     TTValue     out, events, processes;
@@ -1880,7 +2566,7 @@ TimeConditionId Engine::createCondition(std::vector<ConditionedTimeBoxId> trigge
 {
     // create an id for the condition and cache it (from ConditionedTimeBoxId because it is mixed with timeConditionMap)
     std::vector<ConditionedTimeBoxId>::iterator it = triggerIds.begin();
-    TimeConditionId conditionId = m_nextConditionedTimeBoxId++;
+    TimeConditionId conditionId = reserveConditionId();
     cacheTimeCondition(conditionId, getTimeCondition(*it));
     appendToCacheReadyCallback(conditionId, *it);
     
@@ -1917,7 +2603,7 @@ void Engine::attachToCondition(TimeConditionId conditionId, ConditionedTimeBoxId
         getTimeCondition(conditionId).send("EventAdd", timeEvent, out);
 
         // modify the cache
-        m_timeConditionMap[triggerId]->object = getTimeCondition(conditionId);
+        getTimeCondition(triggerId) = getTimeCondition(conditionId);
         m_conditionsMap[conditionId].push_back(triggerId);
         
         appendToCacheReadyCallback(conditionId, triggerId);
@@ -1930,7 +2616,7 @@ void Engine::detachFromCondition(TimeConditionId conditionId, ConditionedTimeBox
     if (m_conditionsMap.find(conditionId) == m_conditionsMap.end())
         return;
     
-    if (m_conditionedTimeBoxMap.find(triggerId) == m_conditionedTimeBoxMap.end())
+    if (!m_conditionedTimeBoxMap.contains(triggerId))
         return;
     
     TimeEventIndex  idx = BEGIN_CONTROL_POINT_INDEX;                 // Because a condition is always at the start of a box
@@ -1962,9 +2648,6 @@ void Engine::detachFromCondition(TimeConditionId conditionId, ConditionedTimeBox
         getTimeCondition(conditionId).send("EventAdd", timeEvent, out);
         setTriggerPointMessage(triggerId, expr);
 
-        // modify cache
-        m_timeConditionMap[triggerId]->object = getTimeCondition(triggerId);
-        
         // théo : it is bad to modify the triggerIds cache here as detachFromCondition is used into a for loop in deleteCondition
         //m_conditionsMap[conditionId].remove(triggerId);
         
@@ -2002,9 +2685,10 @@ void Engine::deleteCondition(TimeConditionId conditionId)
         }
     }
 
-    // uncache the condition
+    // uncache the condition and release its id
     uncacheTimeCondition(conditionId);
     m_conditionsMap.erase(conditionId);
+    m_conditionedTimeBoxMap.erase(conditionId);
 }
 
 void Engine::getConditionTriggerIds(TimeConditionId conditionId, std::vector<TimeBoxId>& triggerIds)
@@ -2130,13 +2814,13 @@ TimeBoxId Engine::getTriggerPointRelatedBoxId(ConditionedTimeBoxId triggerId)
     // look for the time process id into the time process map
     for (it = m_timeBoxMap.begin(); it != m_timeBoxMap.end(); ++it)
     {
-        TTObject mainProcess = it->second->object;
-        if (it->second->loop.valid())
-            mainProcess = it->second->loop;
+        TTObject mainProcess = it->object;
+        if (it->loop.valid())
+            mainProcess = it->loop;
         
         if (mainProcess == conditionedProcess)
         {
-            id = it->first;
+            id = it.id();
             break;
         }
     }
@@ -2146,7 +2830,12 @@ TimeBoxId Engine::getTriggerPointRelatedBoxId(ConditionedTimeBoxId triggerId)
 
 TimeEventIndex Engine::getTriggerPointRelatedCtrlPointIndex(ConditionedTimeBoxId triggerId)
 {
-    return m_conditionedTimeBoxMap[triggerId]->index;;
+    EngineCacheElementPtr e = m_conditionedTimeBoxMap.find(triggerId);
+    
+    if (!e)
+        return unknownCacheElement("getTriggerPointRelatedCtrlPointIndex", triggerId).index;
+    
+    return e->index;
 }
 
 void Engine::getBoxesId(vector<TimeBoxId>& boxesID)
@@ -2156,48 +2845,147 @@ void Engine::getBoxesId(vector<TimeBoxId>& boxesID)
     boxesID.clear();
     
     for (it = m_timeBoxMap.begin(); it != m_timeBoxMap.end(); ++it)
-        boxesID.push_back(it->first);
+        boxesID.push_back(it.id());
 }
 
-void Engine::getRelationsId(vector<IntervalId>& relationsID)
+void Engine::getBoxDescriptor(TimeBoxId boxId, EngineCacheElement& e, BoxDescriptor& descriptor)
 {
-    EngineCacheMapIterator it;
+    TTObject    mainProcess = e.loop.valid() ? e.loop : e.object;
+    TTSymbol    name;
+    TTValue     v;
     
-    relationsID.clear();
+    descriptor.id = boxId;
+    descriptor.parentId = e.parent;
+    descriptor.loopState = e.loop.valid();
     
-    for (it = m_intervalMap.begin(); it != m_intervalMap.end(); ++it)
-        relationsID.push_back(it->first);
+    // format name replacing '_' by ' ' (like getBoxName)
+    e.object.get("name", name);
+    descriptor.name = name.c_str();
+    std::replace(descriptor.name.begin(), descriptor.name.end(), '_', ' ');
+    
+    mainProcess.get("startDate", v);
+    descriptor.beginTime = v[0];
+    
+    mainProcess.get("endDate", v);
+    descriptor.endTime = v[0];
+    
+    mainProcess.get("duration", v);
+    descriptor.duration = v[0];
+    
+    e.object.get("verticalPosition", v);
+    descriptor.verticalPosition = v[0];
+    
+    e.object.get("verticalSize", v);
+    descriptor.verticalSize = v[0];
+    
+    e.object.get("color", v);
+    descriptor.color = QColor(v[0], v[1], v[2]);
+    
+    e.object.get("mute", v);
+    descriptor.muteState = TTBoolean(v[0]);
 }
 
-void Engine::getTriggersPointId(vector<ConditionedTimeBoxId>& triggersID)
+void Engine::getBoxesDescriptors(vector<BoxDescriptor>& descriptors)
 {
     EngineCacheMapIterator it;
     
-    triggersID.clear();
+    descriptors.clear();
+    descriptors.reserve(m_timeBoxMap.size());
     
-    for (it = m_conditionedTimeBoxMap.begin(); it != m_conditionedTimeBoxMap.end(); ++it)
-        triggersID.push_back(it->first);
+    for (it = m_timeBoxMap.begin(); it != m_timeBoxMap.end(); ++it)
+    {
+        if (it.id() == ROOT_BOX_ID)
+            continue;
+        
+        descriptors.push_back(BoxDescriptor());
+        getBoxDescriptor(it.id(), *it, descriptors.back());
+    }
 }
 
-void Engine::getConditionsId(vector<TimeConditionId>& conditionsID)
+void Engine::getBoxesDates(MovedTimeBoxes& dates)
 {
-    std::map<TimeConditionId, std::list<ConditionedTimeBoxId>>::iterator it;
-
-    conditionsID.clear();
-
-    for(it = m_conditionsMap.begin() ; it != m_conditionsMap.end() ; ++it) {
-        conditionsID.push_back(it->first);
+    EngineCacheMapIterator it;
+    TTValue v;
+    
+    dates.clear();
+    dates.reserve(m_timeBoxMap.size());
+    
+    for (it = m_timeBoxMap.begin(); it != m_timeBoxMap.end(); ++it)
+    {
+        if (it.id() == ROOT_BOX_ID)
+            continue;
+        
+        TTObject mainProcess = it->loop.valid() ? it->loop : it->object;
+        TimeValue start, end;
+        
+        mainProcess.get("startDate", v);
+        start = v[0];
+        
+        mainProcess.get("endDate", v);
+        end = v[0];
+        
+        dates.push_back(MovedTimeBox(it.id(), start, end));
     }
 }
 
-bool Engine::enableLoop(TimeBoxId boxId)
+void Engine::getBoxesDescriptors(const vector<TimeBoxId>& boxesID, vector<BoxDescriptor>& descriptors)
 {
-    if (boxId != ROOT_BOX_ID)
+    EngineCacheElementPtr e;
+    
+    descriptors.clear();
+    descriptors.reserve(boxesID.size());
+    
+    for (vector<TimeBoxId>::const_iterator it = boxesID.begin(); it != boxesID.end(); ++it)
     {
-        TTObject    automation = getAutomation(boxId);
-        TTObject    subScenario = getSubScenario(boxId);
-        TTObject    parentScenario = getAutomation(getParentId(boxId));
-        TTValue     v, out, args;
+        if (!(e = m_timeBoxMap.find(*it)))
+            continue;
+        
+        descriptors.push_back(BoxDescriptor());
+        getBoxDescriptor(*it, *e, descriptors.back());
+    }
+}
+
+void Engine::getRelationsId(vector<IntervalId>& relationsID)
+{
+    EngineCacheMapIterator it;
+    
+    relationsID.clear();
+    
+    for (it = m_intervalMap.begin(); it != m_intervalMap.end(); ++it)
+        relationsID.push_back(it.id());
+}
+
+void Engine::getTriggersPointId(vector<ConditionedTimeBoxId>& triggersID)
+{
+    EngineCacheMapIterator it;
+    
+    triggersID.clear();
+    
+    // skip the ids reserved for conditions
+    for (it = m_conditionedTimeBoxMap.begin(); it != m_conditionedTimeBoxMap.end(); ++it)
+        if (it->index != NO_ID)
+            triggersID.push_back(it.id());
+}
+
+void Engine::getConditionsId(vector<TimeConditionId>& conditionsID)
+{
+    std::map<TimeConditionId, std::list<ConditionedTimeBoxId>>::iterator it;
+
+    conditionsID.clear();
+
+    for(it = m_conditionsMap.begin() ; it != m_conditionsMap.end() ; ++it) {
+        conditionsID.push_back(it->first);
+    }
+}
+
+bool Engine::enableLoop(TimeBoxId boxId)
+{
+    if (boxId != ROOT_BOX_ID)
+    {
+        TTObject    automation = getAutomation(boxId);
+        TTObject    subScenario = getSubScenario(boxId);
+        TTObject    parentScenario = getAutomation(getParentId(boxId));
+        TTValue     v, out, args;
         
         // remove the automation and sub scenario from the mother scenario
         parentScenario.send("TimeProcessRemove", automation, out);
@@ -2225,10 +3013,10 @@ bool Engine::enableLoop(TimeBoxId boxId)
         
         // update m_conditionedTimeBoxMap object
         EngineCacheMapIterator it;
-        for (it = m_conditionedTimeBoxMap.begin(); it != m_conditionedTimeBoxMap.end(); it++)
+        for (it = m_conditionedTimeBoxMap.begin(); it != m_conditionedTimeBoxMap.end(); ++it)
         {
-            if (it->second->object == automation)
-                it->second->object = loop;
+            if (it->object == automation)
+                it->object = loop;
         }
     }
     // for main scenario
@@ -2299,10 +3087,10 @@ bool Engine::disableLoop(TimeBoxId boxId)
         
         // update m_conditionedTimeBoxMap object
         EngineCacheMapIterator it;
-        for (it = m_conditionedTimeBoxMap.begin(); it != m_conditionedTimeBoxMap.end(); it++)
+        for (it = m_conditionedTimeBoxMap.begin(); it != m_conditionedTimeBoxMap.end(); ++it)
         {
-            if (it->second->object == loop)
-                it->second->object = automation;
+            if (it->object == loop)
+                it->object = automation;
         }
     }
     // for main scenario
@@ -2323,7 +3111,9 @@ bool Engine::disableLoop(TimeBoxId boxId)
 
 bool Engine::isLoop(TimeBoxId boxId)
 {
-    return m_timeBoxMap[boxId]->loop.valid();
+    EngineCacheElementPtr e = m_timeBoxMap.find(boxId);
+    
+    return e && e->loop.valid();
 }
 
 void Engine::setViewZoom(QPointF zoom)
@@ -2394,6 +3184,9 @@ bool Engine::play(TimeBoxId boxId)
     TTLogMessage("Engine::play\n");
     
     TTBoolean success = !getMainProcess(boxId).send("Start");
+    
+    // publish the new state at once then keep sampling it during the execution
+    startExecutionStateSampling();
   
     return success;
 }
@@ -2417,6 +3210,8 @@ bool Engine::stop(TimeBoxId boxId)
 {
     // stop a time process its end event (this will also stop other time processes attached to the end event)
     TTBoolean success = !getMainProcess(boxId).send("End");
+    
+    sampleExecutionState();
   
     TTLogMessage("Engine::stopped\n");
     TTLogMessage("***************************************\n");
@@ -2438,6 +3233,8 @@ void Engine::pause(bool pauseValue, TimeBoxId boxId)
         if (boxId != ROOT_BOX_ID&& !isLoop(boxId))
             getSubScenario(boxId).send("Resume");
     }
+    
+    sampleExecutionState();
 }
 
 bool Engine::isPaused(TimeBoxId boxId)
@@ -2479,6 +3276,215 @@ float Engine::getCurrentExecutionPosition(TimeBoxId boxId)
     return position > 1. ? 1. : position;
 }
 
+const ExecutionState& Engine::getExecutionState()
+{
+    return m_executionStateBuffer.read();
+}
+
+bool Engine::sampleExecutionState()
+{
+    ExecutionEvent event;
+    
+    // the scheduler callbacks only queue their changes : the maps are built here
+    std::lock_guard<std::mutex> lock(m_executionStateMutex);
+    
+    while (m_executionStateEvents.pop(event)) {
+        
+        if (event.type == ExecutionEvent::BoxRunning) {
+            
+            if (event.value)
+                m_executionState.positions[event.id] = 0.;
+            else
+                m_executionState.positions.erase(event.id);
+        }
+        else
+            m_executionState.triggers[event.id] = event.value;
+    }
+    
+    // some changes were lost : forget the boxes which ended and ask the GUI thread to notify everything again
+    if (m_executionStateOverflow.exchange(false)) {
+        
+        for (auto it = m_executionState.positions.begin(); it != m_executionState.positions.end();) {
+            
+            if (isPlaying(it->first))
+                ++it;
+            else
+                it = m_executionState.positions.erase(it);
+        }
+        
+        m_executionEventsOverflow = true;
+    }
+    
+    m_executionState.running = isPlaying();
+    m_executionState.paused = isPaused();
+    m_executionState.date = getCurrentExecutionDate();
+    
+    for (auto& it : m_executionState.positions)
+        it.second = getCurrentExecutionPosition(it.first);
+    
+    publishExecutionState();
+    
+    return m_executionState.running || !m_executionState.positions.empty();
+}
+
+void Engine::publishExecutionState()
+{
+    m_executionStateBuffer.back() = m_executionState;
+    m_executionStateBuffer.publish();
+}
+
+void Engine::setExecutionBoxRunning(TimeBoxId boxId, bool running)
+{
+    ExecutionEvent event;
+    
+    event.type = ExecutionEvent::BoxRunning;
+    event.id = boxId;
+    event.value = running;
+    
+    if (!m_executionStateEvents.push(event))
+        m_executionStateOverflow = true;
+}
+
+void Engine::setExecutionTriggerActive(ConditionedTimeBoxId triggerId, bool active)
+{
+    ExecutionEvent event;
+    
+    event.type = ExecutionEvent::TriggerActive;
+    event.id = triggerId;
+    event.value = active;
+    
+    if (!m_executionStateEvents.push(event))
+        m_executionStateOverflow = true;
+}
+
+void Engine::startExecutionStateSampling()
+{
+    stopExecutionStateSampling();
+    
+    sampleExecutionState();
+    
+    m_executionStateSampling = true;
+    m_executionStateSampler = std::thread([this] () {
+        
+        while (m_executionStateSampling && sampleExecutionState())
+            std::this_thread::sleep_for(std::chrono::milliseconds(EXECUTION_STATE_PERIOD));
+    });
+}
+
+void Engine::stopExecutionStateSampling()
+{
+    m_executionStateSampling = false;
+    
+    if (m_executionStateSampler.joinable())
+        m_executionStateSampler.join();
+}
+
+void Engine::pushExecutionEvent(ExecutionEvent::Type type, unsigned int id, bool value)
+{
+    ExecutionEvent event;
+    
+    event.type = type;
+    event.id = id;
+    event.value = value;
+    
+    // the schedulers, the network thread (conditions) and the caller of stop push without locking
+    if (!m_executionEvents.push(event))
+        m_executionEventsOverflow = true;
+}
+
+bool Engine::isTriggerActive(ConditionedTimeBoxId triggerId)
+{
+    TimeEventIndex  controlPointId;
+    TTObject        timeEvent, condition;
+    TTValue         v;
+    TTSymbol        status;
+    TTBoolean       ready = true;
+    
+    // the trigger point can be removed before its notification is processed
+    if (!m_conditionedTimeBoxMap.contains(triggerId))
+        return false;
+    
+    TTObject timeProcess = getConditionedTimeProcess(triggerId, controlPointId);
+    
+    if (controlPointId == NO_ID)
+        return false;
+    
+    // get start or end time event
+    if (controlPointId == BEGIN_CONTROL_POINT_INDEX)
+        timeProcess.get("startEvent", v);
+    else
+        timeProcess.get("endEvent", v);
+    
+    timeEvent = v[0];
+    
+    timeEvent.get("status", v);
+    status = v[0];
+    
+    if (status != kTTSym_eventPending)
+        return false;
+    
+    // get event condition ready state
+    timeEvent.get("condition", v);
+    condition = v[0];
+    
+    if (condition.valid())
+        condition.get("ready", ready);
+    
+    return ready;
+}
+
+void Engine::processExecutionEvents()
+{
+    std::map<TimeBoxId, bool>                       boxes;
+    std::map<ConditionedTimeBoxId, ExecutionEvent>  triggers;
+    ExecutionEvent                                  event;
+    
+    // only the last state of each box and trigger point is notified
+    while (m_executionEvents.pop(event)) {
+        
+        if (event.type == ExecutionEvent::BoxRunning)
+            boxes[event.id] = event.value;
+        else
+            triggers[event.id] = event;
+    }
+    
+    // some notifications were lost : notify the state of all boxes and trigger points again
+    if (m_executionEventsOverflow.exchange(false)) {
+        
+        EngineCacheMapIterator it;
+        
+        for (it = m_timeBoxMap.begin(); it != m_timeBoxMap.end(); ++it)
+            boxes[it.id()] = isPlaying(it.id());
+        
+        event.type = ExecutionEvent::TriggerStatus;
+        
+        for (it = m_conditionedTimeBoxMap.begin(); it != m_conditionedTimeBoxMap.end(); ++it) {
+            
+            // condition ids are also reserved here but they are not trigger points
+            if (it->index != NO_ID) {
+                event.id = it.id();
+                triggers[it.id()] = event;
+            }
+        }
+    }
+    
+    if (m_TimeProcessSchedulerRunningAttributeCallback != nullptr) {
+        
+        for (auto& it : boxes)
+            m_TimeProcessSchedulerRunningAttributeCallback(it.first, it.second);
+    }
+    
+    for (auto& it : triggers) {
+        
+        bool active = it.second.type == ExecutionEvent::TriggerReady ? it.second.value : isTriggerActive(it.first);
+        
+        setExecutionTriggerActive(it.first, active);
+        
+        if (m_TimeEventStatusAttributeCallback != nullptr)
+            m_TimeEventStatusAttributeCallback(it.first, active);
+    }
+}
+
 void Engine::setExecutionSpeedFactor(float factor, TimeBoxId boxId)
 {
     // TODO : TTTimeProcess should extend Scheduler class
@@ -2497,6 +3503,317 @@ float Engine::getExecutionSpeedFactor(TimeBoxId boxId)
     return TTFloat64(out[0]);
 }
 
+/** the key of the binary traces written by exportScore */
+static const char       EXPORT_TRACE_MAGIC[4] = {'I', 'S', 'T', 'R'};
+static const TTUInt32   EXPORT_TRACE_VERSION = 2;
+
+/** the execution features a score export ignores, written in the header of its trace */
+static const char       EXPORT_TRACE_IGNORED[] = "score export without the scheduler : "
+                                                 "the trigger points happen at their date without their conditions, "
+                                                 "the loops are played once, "
+                                                 "the execution speed and start point are ignored, "
+                                                 "the curves are sampled at their own rate instead of the scheduler granularity, "
+                                                 "the received messages are ignored";
+
+// the order of the messages exported at the same date : the start states, the curves values then the end states
+#define EXPORT_START_STATE 0
+#define EXPORT_END_STATE 2
+
+/** a state line sent at a date by a score export */
+class ExportedStateLine {
+    
+public:
+    TimeValue       date;
+    unsigned int    order;
+    AddressId       address;
+    TTValue         value;
+    
+    bool operator<(const ExportedStateLine& other) const
+    {
+        return date < other.date || (date == other.date && order < other.order);
+    }
+};
+
+/** the values of a curve sent regularly from the start to the end of its box by a score export */
+class ExportedCurve {
+    
+public:
+    TimeValue       begin;
+    TimeValue       duration;
+    AddressId       address;
+    bool            redundancy;                 // true to skip a value equal to the previous one
+    CurveSamples    values;
+    unsigned int    next;                       // the index of the next value to send
+    
+    TimeValue nextDate() const
+    {
+        if (values->size() < 2)
+            return begin;
+        
+        return begin + TimeValue((TTUInt64(duration) * next) / (values->size() - 1));
+    }
+};
+
+/** orders the curves of a score export by the date of their next value (the earliest on the top of a heap) */
+class ExportedCurveIsLater {
+    
+public:
+    bool operator()(const ExportedCurve* a, const ExportedCurve* b) const
+    {
+        TimeValue dateA = a->nextDate();
+        TimeValue dateB = b->nextDate();
+        
+        return dateA > dateB || (dateA == dateB && a->address > b->address);
+    }
+};
+
+/** writes the messages of a score export into a trace file */
+class ExportTraceWriter {
+    
+    std::ofstream   m_file;
+    TraceFormat     m_format;
+    
+    void writeString(const std::string& s)
+    {
+        TTUInt32 size = s.size();
+        
+        m_file.write((const char*)&size, sizeof(size));
+        m_file.write(s.data(), size);
+    }
+    
+    // the device and the path of an address (device/path) as two csv fields
+    void writeAddress(AddressId address)
+    {
+        const std::string& s = AddressTable::getInstance().address(address);
+        size_t slash = s.find('/');
+        
+        m_file.put(',');
+        
+        if (slash == std::string::npos)
+            m_file << s << ",/";
+        else
+            m_file.write(s.data(), slash).put(',').write(s.data() + slash, s.size() - slash);
+    }
+    
+    void writeRecord(TimeValue date, AddressId address, TTUInt8 type)
+    {
+        TTUInt32 id = address;
+        
+        m_file.write((const char*)&date, sizeof(date));
+        m_file.write((const char*)&id, sizeof(id));
+        m_file.write((const char*)&type, sizeof(type));
+    }
+    
+public:
+    TTUInt64        count;                      /// the number of messages written
+    
+    ExportTraceWriter(const std::string& filepath, TraceFormat format) :
+    m_file(filepath.c_str(), std::ios::binary | std::ios::trunc), m_format(format), count(0) {}
+    
+    bool good() { return m_file.good(); }
+    
+    void writeHeader(const std::set<AddressId>& addresses)
+    {
+        if (m_format == TraceCSV) {
+            
+            m_file << "# " << EXPORT_TRACE_IGNORED << '\n';
+            m_file << "date,device,address,value\n";
+            return;
+        }
+        
+        TTUInt32 size = addresses.size();
+        
+        m_file.write(EXPORT_TRACE_MAGIC, sizeof(EXPORT_TRACE_MAGIC));
+        m_file.write((const char*)&EXPORT_TRACE_VERSION, sizeof(EXPORT_TRACE_VERSION));
+        writeString(EXPORT_TRACE_IGNORED);
+        m_file.write((const char*)&size, sizeof(size));
+        
+        for (std::set<AddressId>::const_iterator it = addresses.begin(); it != addresses.end(); it++) {
+            
+            TTUInt32 id = *it;
+            
+            m_file.write((const char*)&id, sizeof(id));
+            writeString(AddressTable::getInstance().address(*it));
+        }
+    }
+    
+    void write(TimeValue date, AddressId address, float value)
+    {
+        if (m_format == TraceCSV) {
+            
+            m_file << date;
+            writeAddress(address);
+            m_file << ',' << value << '\n';
+        }
+        else {
+            
+            writeRecord(date, address, 0);
+            m_file.write((const char*)&value, sizeof(value));
+        }
+        
+        count++;
+    }
+    
+    void write(TimeValue date, AddressId address, TTValue value)
+    {
+        std::string text;
+        
+        if (value.size()) {
+            
+            value.toString();
+            text = TTString(value[0]).c_str();
+        }
+        
+        if (m_format == TraceCSV) {
+            
+            m_file << date;
+            writeAddress(address);
+            m_file << ',';
+            
+            // quote the values which would break the line
+            if (text.find_first_of(",\"\n") == std::string::npos)
+                m_file << text;
+            else {
+                
+                m_file << '"';
+                
+                for (std::string::iterator c = text.begin(); c != text.end(); c++) {
+                    
+                    if (*c == '"')
+                        m_file << '"';
+                    
+                    m_file << *c;
+                }
+                
+                m_file << '"';
+            }
+            
+            m_file << '\n';
+        }
+        else {
+            
+            writeRecord(date, address, 1);
+            writeString(text);
+        }
+        
+        count++;
+    }
+};
+
+bool Engine::exportScore(const std::string& filepath, TraceFormat format, TTUInt64& nbMessages)
+{
+    std::vector<ExportedStateLine>  stateLines;
+    std::vector<ExportedCurve>      curves;
+    std::set<AddressId>             addresses;
+    EngineCacheMapIterator          it;
+    
+    nbMessages = 0;
+    
+    // collect what each box sends from the score
+    for (it = m_timeBoxMap.begin(); it != m_timeBoxMap.end(); ++it) {
+        
+        TimeBoxId   boxId = it.id();
+        
+        if (boxId == ROOT_BOX_ID || isBoxMutedInScore(boxId))
+            continue;
+        
+        TimeValue   begin = getBoxAbsoluteBeginTime(boxId);
+        TimeValue   duration = getBoxDuration(boxId);
+        
+        for (TimeEventIndex controlPointIndex = BEGIN_CONTROL_POINT_INDEX; controlPointIndex <= END_CONTROL_POINT_INDEX; controlPointIndex++) {
+            
+            StateLines  state;
+            
+            if (getCtrlPointMutingState(boxId, controlPointIndex))
+                continue;
+            
+            getCtrlPointState(boxId, controlPointIndex, state);
+            
+            for (StateLines::iterator line = state.begin(); line != state.end(); line++) {
+                
+                ExportedStateLine exported;
+                
+                exported.date = controlPointIndex == BEGIN_CONTROL_POINT_INDEX ? begin : begin + duration;
+                exported.order = controlPointIndex == BEGIN_CONTROL_POINT_INDEX ? EXPORT_START_STATE : EXPORT_END_STATE;
+                exported.address = line->address;
+                exported.value = line->value;
+                
+                stateLines.push_back(exported);
+                addresses.insert(line->address);
+            }
+        }
+        
+        std::vector<AddressId> curveAddresses;
+        getCurvesAddress(boxId, curveAddresses);
+        
+        for (std::vector<AddressId>::iterator address = curveAddresses.begin(); address != curveAddresses.end(); address++) {
+            
+            ExportedCurve curve;
+            
+            // the values as the automation sends them, at the sample rate of the curve
+            if (getCurveMuteState(boxId, *address) || !getCurveValues(boxId, *address, 0, curve.values) || curve.values->empty())
+                continue;
+            
+            curve.begin = begin;
+            curve.duration = duration;
+            curve.address = *address;
+            curve.redundancy = getCurveRedundancy(boxId, *address);
+            curve.next = 0;
+            
+            curves.push_back(curve);
+            addresses.insert(*address);
+        }
+    }
+    
+    // the states of a box keep their order
+    std::stable_sort(stateLines.begin(), stateLines.end());
+    
+    ExportTraceWriter trace(filepath, format);
+    
+    if (!trace.good())
+        return 1;
+    
+    trace.writeHeader(addresses);
+    
+    std::priority_queue<ExportedCurve*, std::vector<ExportedCurve*>, ExportedCurveIsLater> pendingCurves;
+    
+    for (std::vector<ExportedCurve>::iterator curve = curves.begin(); curve != curves.end(); curve++)
+        pendingCurves.push(&*curve);
+    
+    std::vector<ExportedStateLine>::iterator line = stateLines.begin();
+    
+    // merge the state lines and the values of the curves by date
+    while (line != stateLines.end() || !pendingCurves.empty()) {
+        
+        if (line != stateLines.end()) {
+            
+            TimeValue curveDate = pendingCurves.empty() ? 0 : pendingCurves.top()->nextDate();
+            
+            if (pendingCurves.empty() || line->date < curveDate || (line->date == curveDate && line->order == EXPORT_START_STATE)) {
+                
+                trace.write(line->date, line->address, line->value);
+                line++;
+                continue;
+            }
+        }
+        
+        ExportedCurve*              curve = pendingCurves.top();
+        const std::vector<float>&   values = *curve->values;
+        
+        pendingCurves.pop();
+        
+        if (!curve->redundancy || curve->next == 0 || values[curve->next] != values[curve->next - 1])
+            trace.write(curve->nextDate(), curve->address, values[curve->next]);
+        
+        if (++curve->next < values.size())
+            pendingCurves.push(curve);
+    }
+    
+    nbMessages = trace.count;
+    
+    return !trace.good();
+}
+
 void Engine::trigger(ConditionedTimeBoxId triggerId)
 {
     TimeEventIndex  controlPointIndex;
@@ -2565,8 +3882,35 @@ void Engine::trigger(vector<ConditionedTimeBoxId> triggerIds)
         lastTimeCondition.send("Trigger", events, out);
 }
 
+std::recursive_mutex& Engine::directoryMutex(const std::string& deviceName)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_devicesMutex);
+    
+    std::unique_ptr<std::recursive_mutex>& directoryMutex = m_directoryMutexes[deviceName];
+    
+    if (!directoryMutex)
+        directoryMutex.reset(new std::recursive_mutex());
+    
+    return *directoryMutex;
+}
+
+TTNodeDirectoryPtr Engine::tryLockDirectory(TTAddress anAddress, std::unique_lock<std::recursive_mutex>& directoryLock)
+{
+    // don't wait for a device which is answering a rebuild
+    directoryLock = std::unique_lock<std::recursive_mutex>(directoryMutex(anAddress.getDirectory().c_str()), std::try_to_lock);
+    
+    if (!directoryLock.owns_lock())
+        return NULL;
+    
+    std::lock_guard<std::recursive_mutex> lock(m_devicesMutex);
+    
+    return accessApplicationDirectoryFrom(anAddress);
+}
+
 void Engine::addNetworkDevice(const std::string & deviceName, const std::string & pluginToUse, const std::string & DeviceIp, const unsigned int & destinationPort, const unsigned int & receptionPort, const bool isInputPort, const std::string & stringPort)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_devicesMutex);
+    
     TTValue     args, none, out;
     TTSymbol    applicationName(deviceName);
     TTObject    anApplication;
@@ -2576,6 +3920,9 @@ void Engine::addNetworkDevice(const std::string & deviceName, const std::string
     // if the application doesn't already exist
     if (!accessApplication(applicationName)) {
         
+        // the addresses of the device could have been cached without directory
+        invalidateAttributeCache();
+        
         // create the application
         m_applicationManager.send("ApplicationInstantiateDistant", applicationName, out);
         anApplication = out[0];
@@ -2618,18 +3965,16 @@ void Engine::addNetworkDevice(const std::string & deviceName, const std::string
             }
         }
         
-        // set the priority, service, tags and rangeBounds attributes as a cached attributes
-        args = kTTSym_priority;
-        args.append(kTTSym_service);
-        args.append(kTTSym_tags);
-        args.append(kTTSym_rangeBounds);
-        args.append(kTTSym_rangeClipmode);
-        anApplication.set("cachedAttributes", args);
+        setCachedAttributes(anApplication);
     }
 }
 
 void Engine::removeNetworkDevice(const std::string & deviceName)
 {
+    // wait for a rebuild of the device to end before to release it
+    std::lock_guard<std::recursive_mutex> directoryLock(directoryMutex(deviceName));
+    std::lock_guard<std::recursive_mutex> lock(m_devicesMutex);
+    
     TTValue     v, out;
     TTSymbol    applicationName(deviceName);
     TTObject    anApplication = accessApplication(applicationName);
@@ -2651,6 +3996,8 @@ void Engine::removeNetworkDevice(const std::string & deviceName)
         
         // realease the application
         m_applicationManager.send("ApplicationRelease", applicationName, out);
+        
+        invalidateAttributeCache();
     }
 }
 
@@ -2663,6 +4010,17 @@ void Engine::sendNetworkMessage(const std::string & stringToSend)
     TTAddress anAddress = toTTAddress(aSymbol.string().data());
     data.copyFrom(v, 1);
     
+    // the message is dropped rather than waiting for a device which is answering a rebuild
+    std::unique_lock<std::recursive_mutex> directoryLock(directoryMutex(anAddress.getDirectory().c_str()), std::try_to_lock);
+    
+    if (!directoryLock.owns_lock()) {
+        
+        TTLogMessage("Engine::sendNetworkMessage : the namespace of %s is being rebuilt\n", anAddress.getDirectory().c_str());
+        return;
+    }
+    
+    std::lock_guard<std::recursive_mutex> lock(m_devicesMutex);
+    
     m_sender.set(kTTSym_address, anAddress);
     m_sender.send(kTTSym_Send, data, out);
 }
@@ -2684,6 +4042,8 @@ void Engine::getProtocolNames(std::vector<std::string>& allProtocolNames)
 
 void Engine::getNetworkDevicesName(std::vector<std::string>& allDeviceNames)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_devicesMutex);
+    
     TTValue     applicationNames;
     TTSymbol    name;
     
@@ -2704,6 +4064,8 @@ void Engine::getNetworkDevicesName(std::vector<std::string>& allDeviceNames)
 
 bool Engine::isNetworkDeviceRequestable(const std::string deviceName)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_devicesMutex);
+    
     TTSymbol    applicationName(deviceName);
     TTObject    anApplication = accessApplication(applicationName);
     TTSymbol    protocolName;
@@ -2726,90 +4088,266 @@ bool Engine::isNetworkDeviceRequestable(const std::string deviceName)
     return discover;
 }
 
+/*!
+ * \brief Gets the value of a node if it is a parameter (a Data or a mirror of a Data with the parameter service).
+ */
+static bool snapshotNode(TTNodePtr aNode, TTValue& value)
+{
+    TTObject    anObject = aNode->getObject();
+    TTValue     v;
+    
+    if (!anObject.valid())
+        return false;
+    
+    // in case of proxy data or mirror object
+    if (anObject.name() == TTSymbol("Data") ||
+        (anObject.name() == kTTSym_Mirror && TTMirrorPtr(anObject.instance())->getName() == TTSymbol("Data")))
+    {
+        // get the service attribute
+        anObject.get("service", v);
+        TTSymbol service = v[0];
+        
+        // ask the value only for parameter
+        if (service == kTTSym_parameter)
+            return !anObject.get("value", value);
+    }
+    
+    return false;
+}
+
+/*!
+ * \brief Appends the value of all the parameters below a node to a snapshot.
+ */
+static void snapshotBelow(TTNodePtr aNode, const std::string& directory, StateLines& snapshot)
+{
+    TTList      returnedChildren;
+    TTAddress   anAddress;
+    TTValue     v;
+    
+    // fill a TTList with all children (because we use * (wilcard) for the name and the instance)
+    aNode->getChildren(S_WILDCARD, S_WILDCARD, returnedChildren);
+    
+    for (returnedChildren.begin(); returnedChildren.end(); returnedChildren.next()) {
+        
+        TTNodePtr childNode = TTNodePtr((TTPtr)returnedChildren.current()[0]);
+        
+        if (snapshotNode(childNode, v)) {
+            
+            childNode->getAddress(anAddress);
+            snapshot.push_back(StateLine(AddressTable::getInstance().intern(directory + anAddress.string().c_str()), v));
+        }
+        
+        snapshotBelow(childNode, directory, snapshot);
+    }
+}
+
 std::vector<std::string> Engine::requestNetworkSnapShot(const std::string & address)
 {
     vector<string>      snapshot;
-    TTAddress           anAddress = toTTAddress(address);
-    TTNodeDirectoryPtr  aDirectory;
-    TTNodePtr           aNode;
-    TTObject            anObject;
-    TTString            s;
-    TTValue             v;
+    vector<AddressId>   addresses(1, AddressTable::getInstance().intern(address));
+    StateLines          state;
     
-    // get the application directory
-    aDirectory = accessApplicationDirectoryFrom(anAddress);
+    requestNetworkSnapShot(addresses, state);
     
-    if (aDirectory) {
+    for (StateLines::iterator it = state.begin(); it != state.end(); it++) {
+        
+        it->value.toString();
+        
+        // append address value to the snapshot
+        snapshot.push_back(address + " " + TTString(it->value[0]).data());
+    }
+    
+    return snapshot;
+}
+
+void Engine::requestNetworkSnapShot(const std::vector<AddressId>& addresses, StateLines& snapshot, bool recursive)
+{
+    AddressTable&                                       table = AddressTable::getInstance();
+    std::map<std::string, std::vector<AddressId> >      addressesByDevice;
+    std::map<std::string, std::vector<AddressId> >::iterator it;
+    TTNodeDirectoryPtr                                  aDirectory;
+    TTNodePtr                                           aNode;
+    TTValue                                             v;
+    
+    // group the addresses by device to access each application directory once
+    for (std::vector<AddressId>::const_iterator idIt = addresses.begin(); idIt != addresses.end(); idIt++)
+        if (*idIt != NO_ADDRESS_ID)
+            addressesByDevice[table.ttAddress(*idIt).getDirectory().c_str()].push_back(*idIt);
+    
+    snapshot.reserve(snapshot.size() + addresses.size());
+    
+    for (it = addressesByDevice.begin(); it != addressesByDevice.end(); it++) {
+        
+        std::unique_lock<std::recursive_mutex> directoryLock;
+        
+        // get the application directory (the devices being rebuilt are skipped)
+        aDirectory = tryLockDirectory(table.ttAddress(it->second.front()), directoryLock);
+        
+        if (!aDirectory)
+            continue;
+        
+        for (std::vector<AddressId>::iterator idIt = it->second.begin(); idIt != it->second.end(); idIt++) {
+            
+            // get the node
+            if (aDirectory->getTTNode(table.ttAddress(*idIt), &aNode))
+                continue;
+            
+            if (snapshotNode(aNode, v))
+                snapshot.push_back(StateLine(*idIt, v));
+            
+            if (recursive)
+                snapshotBelow(aNode, it->first, snapshot);
+        }
+    }
+}
+
+/** tell if an attribute is cached by getObjectAttribute : the type (empty name) and the attributes which only change with the namespace */
+static bool isCachedAttribute(const std::string& attribute)
+{
+    static const std::set<std::string> staticAttributes = {"", "type", "priority", "service", "tags", "rangeBounds", "rangeClipmode"};
+    
+    return staticAttributes.count(attribute) != 0;
+}
+
+AttributeCacheElement
+Engine::getObjectAttribute(AddressId address, const std::string & attribute)
+{
+    std::pair<AddressId, std::string>       key(address, attribute);
+    std::chrono::steady_clock::time_point   now = std::chrono::steady_clock::now();
+    AttributeCacheElement                   element;
+    TTAddress                               anAddress;
+    TTNodeDirectoryPtr                      aDirectory;
+    TTNodePtr                               aNode;
+    TTObject                                anObject;
+    TTSymbol                                type;
+    unsigned int                            epoch = 0;
+    bool                                    cached = isCachedAttribute(attribute);
+    
+    if (cached) {
+        
+        std::lock_guard<std::mutex> lock(m_attributeCacheMutex);
+        
+        AttributeCacheMap::iterator it = m_attributeCache.find(key);
+        
+        if (it != m_attributeCache.end() &&
+            (!it->second.remote || m_attributeCacheTTL.count() == 0 || now - it->second.date < m_attributeCacheTTL))
+            return it->second;
+        
+        epoch = m_attributeCacheEpoch;
+    }
+    
+    element.date = now;
+    anAddress = AddressTable::getInstance().ttAddress(address);
     
-        // get the node
+    std::unique_lock<std::recursive_mutex> directoryLock;
+    
+    aDirectory = tryLockDirectory(anAddress, directoryLock);
+    
+    // don't wait for the device : the caller can ask again once the rebuild ended
+    if (!directoryLock.owns_lock()) {
+        
+        element.status = AttributeCacheElement::Busy;
+        return element;
+    }
+    
+    if (aDirectory) {
+        
+        element.status = AttributeCacheElement::NoObject;
+        
         if (!aDirectory->getTTNode(anAddress, &aNode)) {
             
-            // get object attributes
             anObject = aNode->getObject();
             
             if (anObject.valid()) {
                 
-                // in case of proxy data or mirror object
-                if (anObject.name() == TTSymbol("Data") ||
-                    (anObject.name() == kTTSym_Mirror && TTMirrorPtr(anObject.instance())->getName() == TTSymbol("Data")))
-                {
-                    // get the service attribute
-                    anObject.get("service", v);
-                    TTSymbol service = v[0];
+                element.status = AttributeCacheElement::NoAttribute;
+                element.remote = anObject.name() == kTTSym_Mirror;
+                
+                // the type of the object
+                if (attribute.empty()) {
                     
-                    // ask the value only for parameter
-                    if (service == kTTSym_parameter) {
-                        
-                        // get the value attribute
-                        if (!anObject.get("value", v)) {
-                            
-                            v.toString();
-                            s = TTString(v[0]);
+                    if (element.remote)
+                        type = TTMirrorPtr(anObject.instance())->getName();
+                    else
+                        type = anObject.name();
+                    
+                    if (type != kTTSymEmpty) {
                         
-                            // append address value to the snapshot
-                            snapshot.push_back(address + " " + s.data());
-                        }
+                        element.status = AttributeCacheElement::Found;
+                        element.value = type;
+                        element.text = type.c_str();
                     }
                 }
+                else if (!anObject.get(TTSymbol(attribute), element.value)) {
+                    
+                    TTValue v = element.value;
+                    
+                    v.toString();
+                    element.status = AttributeCacheElement::Found;
+                    element.text = TTString(v[0]).data();
+                }
             }
         }
     }
     
-    return snapshot;
+    directoryLock.unlock();
+    
+    if (!cached)
+        return element;
+    
+    std::lock_guard<std::mutex> lock(m_attributeCacheMutex);
+    
+    // the namespace changed while the directory was read : the element may already be stale
+    if (epoch == m_attributeCacheEpoch)
+        m_attributeCache[key] = element;
+    
+    return element;
+}
+
+void
+Engine::invalidateAttributeCache(AddressId address)
+{
+    std::lock_guard<std::mutex> lock(m_attributeCacheMutex);
+    
+    m_attributeCacheEpoch++;
+    
+    if (address == NO_ADDRESS_ID) {
+        
+        m_attributeCache.clear();
+        return;
+    }
+    
+    // the attributes of an address are stored one after the other
+    AttributeCacheMap::iterator it = m_attributeCache.lower_bound(std::make_pair(address, std::string()));
+    
+    while (it != m_attributeCache.end() && it->first.first == address)
+        it = m_attributeCache.erase(it);
+}
+
+void
+Engine::setAttributeCacheTTL(unsigned int milliseconds)
+{
+    std::lock_guard<std::mutex> lock(m_attributeCacheMutex);
+    
+    m_attributeCacheTTL = std::chrono::milliseconds(milliseconds);
 }
 
 int
 Engine::requestObjectAttributeValue(const std::string & address, const std::string & attribute, vector<string>& value)
 {
-    TTAddress           anAddress = toTTAddress(address);
-    TTNodeDirectoryPtr  aDirectory;
-    TTNodePtr           aNode;
-    TTObject            anObject;
-    TTString            s;
-    TTValue             v;
-
-    aDirectory = accessApplicationDirectoryFrom(anAddress);
+    AttributeCacheElement element = getObjectAttribute(AddressTable::getInstance().intern(address), attribute);
+    
     value.clear();
-
-    if (!aDirectory)
+    
+    if (element.status == AttributeCacheElement::NoDirectory)
+        return 1;
+    
+    if (element.status == AttributeCacheElement::Found) {
+        
+        value.push_back(element.text);
         return 1;
-
-    if (!aDirectory->getTTNode(anAddress, &aNode)) {
-
-        // get object attributes
-        anObject = aNode->getObject();
-
-        if (anObject.valid()) {
-            
-            if (!anObject.get(TTSymbol(attribute), v)) {
-                
-                v.toString();
-                s = TTString(v[0]);
-                value.push_back(s.c_str());
-                return 1;
-            }
-        }
     }
+    
     return 0;
 }
 
@@ -2821,10 +4359,15 @@ Engine::setObjectAttributeValue(const std::string & address, const std::string &
     TTNodePtr           aNode;
     TTObject            anObject;
     TTValue             v;
+    std::unique_lock<std::recursive_mutex> directoryLock;
     
-    aDirectory = accessApplicationDirectoryFrom(anAddress);
+    aDirectory = tryLockDirectory(anAddress, directoryLock);
     value.clear();
     
+    // the namespace of the device is being rebuilt
+    if (!directoryLock.owns_lock())
+        return 0;
+    
     if (!aDirectory)
         return 1;
     
@@ -2838,8 +4381,10 @@ Engine::setObjectAttributeValue(const std::string & address, const std::string &
             v = TTString(value);
             v.fromString();
       
-            if(!anObject.set(TTSymbol(attribute), v))
+            if(!anObject.set(TTSymbol(attribute), v)) {
+                invalidateAttributeCache(AddressTable::getInstance().intern(anAddress));
                 return 1;
+            }
         }
     }
     return 0;
@@ -2848,35 +4393,14 @@ Engine::setObjectAttributeValue(const std::string & address, const std::string &
 int
 Engine::requestObjectType(const std::string & address, std::string & nodeType)
 {
-    TTNodeDirectoryPtr  aDirectory;
-    TTAddress           anAddress = toTTAddress(address);
-    TTSymbol            type;
-    TTObject            anObject;
-    TTNodePtr           aNode;
+    AttributeCacheElement element = getObjectAttribute(AddressTable::getInstance().intern(address), "");
 
     nodeType = "none";
-    aDirectory = accessApplicationDirectoryFrom(anAddress);
-
-    if (!aDirectory)
-        return 0;
 
-    if (!aDirectory->getTTNode(anAddress, &aNode)) {
+    if (element.status == AttributeCacheElement::Found) {
 
-        anObject = aNode->getObject();
-        
-        if (anObject.valid()) {
-            
-            if (anObject.name() == kTTSym_Mirror)
-                type = TTMirrorPtr(anObject.instance())->getName();
-            else
-                type = anObject.name();
-            
-            if (type != kTTSymEmpty) {
-                
-                nodeType = type.c_str();
-                return 1;
-            }
-        }
+        nodeType = element.text;
+        return 1;
     }
     return 0;
 }
@@ -2884,29 +4408,14 @@ Engine::requestObjectType(const std::string & address, std::string & nodeType)
 int
 Engine::requestObjectPriority(const std::string &address, unsigned int &priority)
 {
-    TTNodeDirectoryPtr  aDirectory;
-    TTAddress           anAddress = toTTAddress(address);
-    TTObject            anObject;
-    TTNodePtr           aNode;
-    TTValue             v;
+    AttributeCacheElement element = getObjectAttribute(AddressTable::getInstance().intern(address), "priority");
 
-    aDirectory = accessApplicationDirectoryFrom(anAddress);
-
-    if (!aDirectory)
-        return 0;
-
-    if (!aDirectory->getTTNode(anAddress, &aNode)) {
+    if (element.status == AttributeCacheElement::NoAttribute)
+        return 1;
 
-        anObject = aNode->getObject();
+    if (element.status == AttributeCacheElement::Found && !element.value.empty())
+        priority = element.value[0];
 
-        if (anObject.valid()) {
-
-            if (!anObject.get(kTTSym_priority, v))
-                priority = v[0];
-            else
-                return 1;
-        }
-    }
     return 0;
 }
 
@@ -2918,8 +4427,10 @@ Engine::requestObjectChildren(const std::string & address, vector<string>& child
     TTNodePtr           aNode, childNode;
     TTList              nodeList;
     TTString            s;
+    std::unique_lock<std::recursive_mutex> directoryLock;
 
-    aDirectory = accessApplicationDirectoryFrom(anAddress);
+    // fails while the namespace of the device is being rebuilt
+    aDirectory = tryLockDirectory(anAddress, directoryLock);
     children.clear();
 
     if (!aDirectory)
@@ -2951,55 +4462,72 @@ Engine::rebuildNetworkNamespace(const string &deviceName, const string &/*addres
 {
     TTValue     v, none;
     TTSymbol    applicationName(deviceName);
-    TTObject    anApplication = accessApplication(applicationName);
+    TTObject    anApplication;
     TTSymbol    protocolName;
-    TTObject    aProtocol;
+    TTSymbol    namespaceFilePath;
     
-    // if the application exists
-    if (anApplication.valid()) {
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_devicesMutex);
+        
+        anApplication = accessApplication(applicationName);
+        
+        // if the application doesn't exist
+        if (!anApplication.valid())
+            return 1;
         
         // get the protocol name used by the application (we register distante application to 1 protocol only)
         protocolName = accessApplicationProtocolNames(applicationName)[0];
         
-        // Minuit case : use discovery mechanism
-        if (protocolName == TTSymbol("Minuit")) {
-            
-            // only if there is no namespace observation !
-            if (m_namespaceObserver.valid())
-                return 1;
-            
-            anApplication.send("DirectoryBuild");
-            return 0;
-        }
-        // OSC case : reload the namespace from the last project file if exist
-        else if (protocolName == TTSymbol("OSC")) {
+        // Minuit case : only if there is no namespace observation !
+        if (protocolName == TTSymbol("Minuit") && m_namespaceObserver.valid())
+            return 1;
+        
+        // OSC case : reload the namespace from the last project file if exist (can't refresh when learning)
+        if (protocolName == TTSymbol("OSC")) {
             
-            // can't refresh when learning
             if (getDeviceLearn(deviceName))
                 return 1;
             
             if (m_namespaceFilesPath.find(deviceName) == m_namespaceFilesPath.end())
                 return 1;
             
-            TTSymbol namespaceFilePath = TTSymbol(m_namespaceFilesPath[deviceName]);
-            
-            // create a TTXmlHandler
-            TTObject aXmlHandler(kTTSym_XmlHandler);
-            
-            // read the file to setup TTModularApplications
-            aXmlHandler.set(kTTSym_object, anApplication);
-            aXmlHandler.send(kTTSym_Read, namespaceFilePath, none);
-            
-            return 0;
+            namespaceFilePath = TTSymbol(m_namespaceFilesPath[deviceName]);
         }
+        else if (protocolName != TTSymbol("Minuit"))
+            return 1;
     }
     
-    return 1;
+    // only the namespace of this device stays locked while it is rebuilt : the readers of this device fail instead of waiting
+    std::lock_guard<std::recursive_mutex> directoryLock(directoryMutex(deviceName));
+    
+    // Minuit case : use discovery mechanism
+    if (protocolName == TTSymbol("Minuit")) {
+        
+        anApplication.send("DirectoryBuild");
+        invalidateAttributeCache();
+        return 0;
+    }
+    // OSC case : read the file to setup TTModularApplications
+    else {
+        
+        // create a TTXmlHandler
+        TTObject aXmlHandler(kTTSym_XmlHandler);
+        
+        aXmlHandler.set(kTTSym_object, anApplication);
+        aXmlHandler.send(kTTSym_Read, namespaceFilePath, none);
+        invalidateAttributeCache();
+        
+        return 0;
+    }
 }
 
 bool
 Engine::loadNetworkNamespace(const string &deviceName, const string &filepath)
 {
+    // wait for a rebuild of the device to end
+    std::lock_guard<std::recursive_mutex> directoryLock(directoryMutex(deviceName));
+    std::lock_guard<std::recursive_mutex> lock(m_devicesMutex);
+    
     TTObject    anApplication = accessApplication(TTSymbol(deviceName));
     TTValue     out;
     TTErr       err;
@@ -3011,6 +4539,7 @@ Engine::loadNetworkNamespace(const string &deviceName, const string &filepath)
     aXmlHandler.set(kTTSym_object, anApplication);
     
     err = aXmlHandler.send(kTTSym_Read, TTSymbol(filepath), out);
+    invalidateAttributeCache();
     
     if (!err) {
         
@@ -3030,9 +4559,311 @@ Engine::loadNetworkNamespace(const string &deviceName, const string &filepath)
     return err != kTTErrNone;
 }
 
+static std::string attributeToString(TTObject& anObject, TTSymbol attribute)
+{
+    TTValue v;
+    
+    if (anObject.get(attribute, v) || v.empty())
+        return "";
+    
+    v.toString();
+    return TTString(v[0]).data();
+}
+
+/*!
+ * \brief Describes a node with its type and the attributes its device caches (see setCachedAttributes).
+ * Note : a Mirror answers these attributes from its cache only if its application caches them,
+ * otherwise each of them is a get request to the device.
+ */
+static void dumpNode(TTNodePtr aNode, const std::string& address, NamespaceNode& node)
+{
+    TTObject    anObject = aNode->getObject();
+    TTSymbol    type;
+    
+    node.address = address;
+    node.type = "none";
+    
+    if (!anObject.valid())
+        return;
+    
+    if (anObject.name() == kTTSym_Mirror)
+        type = TTMirrorPtr(anObject.instance())->getName();
+    else
+        type = anObject.name();
+    
+    if (type != kTTSymEmpty)
+        node.type = type.c_str();
+    
+    node.service = attributeToString(anObject, kTTSym_service);
+    node.priority = attributeToString(anObject, kTTSym_priority);
+    node.tags = attributeToString(anObject, kTTSym_tags);
+    node.range = attributeToString(anObject, kTTSym_rangeBounds);
+    node.clipmode = attributeToString(anObject, kTTSym_rangeClipmode);
+}
+
+/*!
+ * \brief Appends the nodes below a node to a dump (each node before its children).
+ */
+static void dumpBelow(TTNodePtr aNode, const std::string& address, NamespaceNodes& dump, bool recursive)
+{
+    TTList      nodeList;
+    TTNodePtr   childNode;
+    TTString    s;
+    
+    aNode->getChildren(S_WILDCARD, S_WILDCARD, nodeList);
+    nodeList.sort(&compareNodePriorityThenNameThenInstance);
+    
+    for (nodeList.begin(); nodeList.end(); nodeList.next()) {
+        
+        childNode = TTNodePtr(TTPtr(nodeList.current()[0]));
+        
+        // prepare name.instance
+        s = childNode->getName().string();
+        if (childNode->getInstance() != kTTSymEmpty) {
+            s += ".";
+            s += childNode->getInstance().string();
+        }
+        
+        std::string childAddress = address + "/" + s.c_str();
+        
+        dump.push_back(NamespaceNode());
+        dumpNode(childNode, childAddress, dump.back());
+        
+        if (recursive)
+            dumpBelow(childNode, childAddress, dump, true);
+    }
+}
+
+/** the first bytes of a namespace cache file and the version of its format */
+static const char       NAMESPACE_CACHE_MAGIC[4] = {'I', 'S', 'N', 'C'};
+static const TTUInt32   NAMESPACE_CACHE_VERSION = 1;
+
+/*!
+ * \brief Computes a FNV-1a hash of the cached nodes (they are sorted by address to not depend on the order of the children).
+ */
+static TTUInt64 namespaceCacheHash(NamespaceNodes& nodes)
+{
+    TTUInt64 hash = 14695981039346656037ULL;
+    
+    std::sort(nodes.begin(), nodes.end(),
+              [](const NamespaceNode& a, const NamespaceNode& b) { return a.address < b.address; });
+    
+    for (NamespaceNodes::iterator it = nodes.begin(); it != nodes.end(); it++) {
+        
+        const std::string* fields[] = {&it->address, &it->service, &it->priority, &it->range, &it->clipmode, &it->tags};
+        
+        for (const std::string* field : fields) {
+            
+            // hash the terminal \0 too to separate the fields
+            for (size_t i = 0; i <= field->size(); i++) {
+                hash ^= (unsigned char)field->c_str()[i];
+                hash *= 1099511628211ULL;
+            }
+        }
+    }
+    
+    return hash;
+}
+
+/*!
+ * \brief Gets the parameters and the hash of the current namespace of a device
+ * (only the parameters are cached : the other nodes are created with them).
+ */
+static bool namespaceCacheNodes(TTSymbol applicationName, NamespaceNodes& nodes, TTUInt64& hash)
+{
+    TTNodeDirectoryPtr  aDirectory = accessApplicationDirectory(applicationName);
+    NamespaceNodes      dump;
+    
+    if (!aDirectory)
+        return 1;
+    
+    dumpBelow(aDirectory->getRoot(), applicationName.c_str(), dump, true);
+    
+    for (NamespaceNodes::iterator it = dump.begin(); it != dump.end(); it++)
+        if (it->type == "Data")
+            nodes.push_back(*it);
+    
+    hash = namespaceCacheHash(nodes);
+    
+    return 0;
+}
+
+static void writeCacheString(std::ofstream& file, const std::string& s)
+{
+    TTUInt32 size = s.size();
+    
+    file.write((const char*)&size, sizeof(size));
+    file.write(s.data(), size);
+}
+
+static bool readCacheString(std::ifstream& file, std::string& s)
+{
+    TTUInt32 size = 0;
+    
+    // a corrupted size must not allocate a huge string
+    if (!file.read((char*)&size, sizeof(size)) || size > 65536)
+        return false;
+    
+    s.resize(size);
+    return size == 0 || file.read(&s[0], size);
+}
+
+bool
+Engine::storeNetworkNamespaceCache(const string &deviceName, const string &filepath)
+{
+    std::unique_lock<std::recursive_mutex> directoryLock(directoryMutex(deviceName), std::try_to_lock);
+    
+    // the namespace of the device is being rebuilt
+    if (!directoryLock.owns_lock())
+        return 1;
+    
+    std::lock_guard<std::recursive_mutex> lock(m_devicesMutex);
+    
+    TTSymbol                applicationName(deviceName);
+    TTSymbol                protocolName;
+    NamespaceNodes          nodes;
+    TTUInt64                hash;
+    TTUInt32                count;
+    
+    if (!accessApplication(applicationName).valid())
+        return 1;
+    
+    if (namespaceCacheNodes(applicationName, nodes, hash))
+        return 1;
+    
+    protocolName = accessApplicationProtocolNames(applicationName)[0];
+    
+    std::ofstream file(filepath.c_str(), std::ios::binary | std::ios::trunc);
+    
+    if (!file)
+        return 1;
+    
+    // header : the key of the cache
+    file.write(NAMESPACE_CACHE_MAGIC, sizeof(NAMESPACE_CACHE_MAGIC));
+    file.write((const char*)&NAMESPACE_CACHE_VERSION, sizeof(NAMESPACE_CACHE_VERSION));
+    writeCacheString(file, deviceName);
+    writeCacheString(file, protocolName.c_str());
+    file.write((const char*)&hash, sizeof(hash));
+    
+    // parameters
+    count = nodes.size();
+    file.write((const char*)&count, sizeof(count));
+    
+    for (NamespaceNodes::iterator it = nodes.begin(); it != nodes.end(); it++) {
+        
+        writeCacheString(file, it->address);
+        writeCacheString(file, it->service);
+        writeCacheString(file, it->priority);
+        writeCacheString(file, it->range);
+        writeCacheString(file, it->clipmode);
+        writeCacheString(file, it->tags);
+    }
+    
+    if (!file.good())
+        return 1;
+    
+    m_namespaceCacheHashes[deviceName] = hash;
+    
+    return 0;
+}
+
+bool
+Engine::loadNetworkNamespaceCache(const string &deviceName, const string &filepath)
+{
+    std::unique_lock<std::recursive_mutex> directoryLock(directoryMutex(deviceName), std::try_to_lock);
+    
+    // the namespace of the device is being rebuilt
+    if (!directoryLock.owns_lock())
+        return 1;
+    
+    std::lock_guard<std::recursive_mutex> lock(m_devicesMutex);
+    
+    TTSymbol                applicationName(deviceName);
+    NamespaceNodes          nodes;
+    std::string             cachedDeviceName, cachedProtocolName;
+    char                    magic[sizeof(NAMESPACE_CACHE_MAGIC)];
+    TTUInt32                version = 0, count = 0;
+    TTUInt64                hash = 0;
+    
+    if (!accessApplication(applicationName).valid())
+        return 1;
+    
+    std::ifstream file(filepath.c_str(), std::ios::binary);
+    
+    if (!file)
+        return 1;
+    
+    // check the key of the cache
+    if (!file.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), NAMESPACE_CACHE_MAGIC))
+        return 1;
+    
+    if (!file.read((char*)&version, sizeof(version)) || version != NAMESPACE_CACHE_VERSION)
+        return 1;
+    
+    if (!readCacheString(file, cachedDeviceName) || cachedDeviceName != deviceName)
+        return 1;
+    
+    if (!readCacheString(file, cachedProtocolName) || TTSymbol(cachedProtocolName) != accessApplicationProtocolNames(applicationName)[0])
+        return 1;
+    
+    if (!file.read((char*)&hash, sizeof(hash)) || !file.read((char*)&count, sizeof(count)))
+        return 1;
+    
+    // read all parameters before to change the namespace
+    for (TTUInt32 i = 0; i < count; i++) {
+        
+        NamespaceNode node;
+        
+        if (!readCacheString(file, node.address) ||
+            !readCacheString(file, node.service) ||
+            !readCacheString(file, node.priority) ||
+            !readCacheString(file, node.range) ||
+            !readCacheString(file, node.clipmode) ||
+            !readCacheString(file, node.tags))
+            return 1;
+        
+        nodes.push_back(node);
+    }
+    
+    // register a proxy data for each parameter
+    for (NamespaceNodes::iterator it = nodes.begin(); it != nodes.end(); it++)
+        appendToNetWorkNamespace(it->address, it->service, "generic", it->priority, "", it->range, it->clipmode, it->tags);
+    
+    invalidateAttributeCache();
+    m_namespaceCacheHashes[deviceName] = hash;
+    
+    return 0;
+}
+
+bool
+Engine::isNetworkNamespaceCacheValid(const string &deviceName)
+{
+    std::unique_lock<std::recursive_mutex> directoryLock(directoryMutex(deviceName), std::try_to_lock);
+    
+    // the namespace of the device is being rebuilt
+    if (!directoryLock.owns_lock())
+        return false;
+    
+    std::lock_guard<std::recursive_mutex> lock(m_devicesMutex);
+    
+    EngineHashesMap::iterator   it = m_namespaceCacheHashes.find(deviceName);
+    NamespaceNodes              nodes;
+    TTUInt64                    hash;
+    
+    if (it == m_namespaceCacheHashes.end())
+        return false;
+    
+    if (namespaceCacheNodes(TTSymbol(deviceName), nodes, hash))
+        return false;
+    
+    return hash == it->second;
+}
+
 bool
 Engine::getDeviceIntegerParameter(const string device, const string protocol, const string parameter, unsigned int &integer)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_devicesMutex);
+    
     TTSymbol    applicationName(device);
     TTObject    aProtocol = accessProtocol(TTSymbol(protocol));
     TTValue     out;
@@ -3057,6 +4888,8 @@ Engine::getDeviceIntegerParameter(const string device, const string protocol, co
 bool
 Engine::getDeviceIntegerVectorParameter(const string device, const string protocol, const string parameter, vector<int>& integerVect)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_devicesMutex);
+    
     TTSymbol    applicationName(device);
     TTObject    aProtocol = accessProtocol(TTSymbol(protocol));
     TTValue     out;
@@ -3083,6 +4916,8 @@ Engine::getDeviceIntegerVectorParameter(const string device, const string protoc
 bool
 Engine::getDeviceStringParameter(const string device, const string protocol, const string parameter, string &string)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_devicesMutex);
+    
     TTSymbol    applicationName(device);
     TTObject    aProtocol = accessProtocol(TTSymbol(protocol));
     TTValue     v, out;
@@ -3109,6 +4944,8 @@ Engine::getDeviceStringParameter(const string device, const string protocol, con
 bool
 Engine::getDeviceProtocol(std::string deviceName, std::string &protocol)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_devicesMutex);
+    
     TTSymbol    applicationName(deviceName);
     TTObject    anApplication = accessApplication(applicationName);
     TTSymbol    protocolName;
@@ -3127,6 +4964,10 @@ Engine::getDeviceProtocol(std::string deviceName, std::string &protocol)
 bool
 Engine::setDeviceName(string deviceName, string newName)
 {
+    // wait for a rebuild of the device to end
+    std::lock_guard<std::recursive_mutex> directoryLock(directoryMutex(deviceName));
+    std::lock_guard<std::recursive_mutex> lock(m_devicesMutex);
+    
     TTSymbol    applicationName(deviceName);
     TTObject    anApplication = accessApplication(applicationName);
     TTSymbol    newApplicationName(newName);
@@ -3134,12 +4975,19 @@ Engine::setDeviceName(string deviceName, string newName)
     
     err = anApplication.set("name", newApplicationName);
     
+    // the addresses of the device changed
+    invalidateAttributeCache();
+    
     return err != kTTErrNone;
 }
 
 bool
 Engine::setDevicePort(string deviceName, int destinationPort, int receptionPort)
 {
+    // wait for a rebuild of the device to end
+    std::lock_guard<std::recursive_mutex> directoryLock(directoryMutex(deviceName));
+    std::lock_guard<std::recursive_mutex> lock(m_devicesMutex);
+    
     TTSymbol    applicationName(deviceName);
     TTObject    anApplication = accessApplication(applicationName);
     TTSymbol    protocolName;
@@ -3182,6 +5030,10 @@ Engine::setDevicePort(string deviceName, int destinationPort, int receptionPort)
 bool
 Engine::setDeviceLocalHost(string deviceName, string localHost)
 {
+    // wait for a rebuild of the device to end
+    std::lock_guard<std::recursive_mutex> directoryLock(directoryMutex(deviceName));
+    std::lock_guard<std::recursive_mutex> lock(m_devicesMutex);
+    
     TTSymbol    applicationName(deviceName);
     TTObject    anApplication = accessApplication(applicationName);
     TTSymbol    protocolName;
@@ -3224,6 +5076,10 @@ Engine::setDeviceLocalHost(string deviceName, string localHost)
 bool
 Engine::setDeviceProtocol(string deviceName, string protocol)
 {
+    // wait for a rebuild of the device to end
+    std::lock_guard<std::recursive_mutex> directoryLock(directoryMutex(deviceName));
+    std::lock_guard<std::recursive_mutex> lock(m_devicesMutex);
+    
     string              oldProtocol,
                         localHost;
     unsigned int        port;
@@ -3248,6 +5104,14 @@ Engine::setDeviceProtocol(string deviceName, string protocol)
 
 bool Engine::setDeviceLearn(std::string deviceName, bool newLearn)
 {
+    std::unique_lock<std::recursive_mutex> directoryLock(directoryMutex(deviceName), std::try_to_lock);
+    
+    // the namespace of the device is being rebuilt
+    if (!directoryLock.owns_lock())
+        return 1;
+    
+    std::lock_guard<std::recursive_mutex> lock(m_devicesMutex);
+    
     TTSymbol    applicationName(deviceName);
     TTObject    anApplication = accessApplication(applicationName);
     
@@ -3288,6 +5152,8 @@ bool Engine::setDeviceLearn(std::string deviceName, bool newLearn)
 
 bool Engine::getDeviceLearn(std::string deviceName)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_devicesMutex);
+    
     TTSymbol    applicationName(deviceName);
     TTObject    anApplication = accessApplication(applicationName);
     TTValue     v;
@@ -3321,6 +5187,7 @@ bool Engine::protocolScan(const std::string & protocol, std::vector<std::string>
 int Engine::requestNetworkNamespace(const std::string & address, std::string & nodeType, vector<string>& nodes, vector<string>& leaves, vector<string>& attributs, vector<string>& attributsValue)
 {
     TTAddress           anAddress = toTTAddress(address);
+    std::unique_lock<std::recursive_mutex> directoryLock;
     TTSymbol            type, service;
     TTNodeDirectoryPtr  aDirectory;
     TTNodePtr           aNode, childNode;
@@ -3329,8 +5196,8 @@ int Engine::requestNetworkNamespace(const std::string & address, std::string & n
     TTString            s;
     TTValue             v;
     
-    // get the application directory
-    aDirectory = accessApplicationDirectoryFrom(anAddress);
+    // get the application directory (fails while the namespace of the device is being rebuilt)
+    aDirectory = tryLockDirectory(anAddress, directoryLock);
     
     if (!aDirectory)
         return 0;
@@ -3448,17 +5315,39 @@ int Engine::requestNetworkNamespace(const std::string & address, std::string & n
     return 0;
 }
 
+int Engine::requestNetworkNamespaceDump(const std::string & address, NamespaceNodes& dump, bool recursive)
+{
+    TTAddress           anAddress = toTTAddress(address);
+    std::unique_lock<std::recursive_mutex> directoryLock;
+    TTNodeDirectoryPtr  aDirectory;
+    TTNodePtr           aNode;
+    
+    // get the application directory (fails while the namespace of the device is being rebuilt)
+    aDirectory = tryLockDirectory(anAddress, directoryLock);
+    
+    if (!aDirectory)
+        return 0;
+    
+    if (aDirectory->getTTNode(anAddress, &aNode))
+        return 0;
+    
+    dumpBelow(aNode, address, dump, recursive);
+    
+    return 1;
+}
+
 int Engine::appendToNetWorkNamespace(const std::string & address, const std::string & service, const std::string & type, const std::string & priority, const std::string & description, const std::string & range, const std::string & clipmode, const std::string & tags)
 {
     TTAddress           anAddress = toTTAddress(address);
-    TTObject            anApplication = accessApplication(anAddress.getDirectory());
+    std::unique_lock<std::recursive_mutex> directoryLock;
+    TTObject            anApplication;
     TTNodeDirectoryPtr  aDirectory;
     TTObject            anObject;
     TTString            s;
     TTValue             v, out;
     
-    // get the application directory
-    aDirectory = accessApplicationDirectoryFrom(anAddress);
+    // get the application directory (fails while the namespace of the device is being rebuilt)
+    aDirectory = tryLockDirectory(anAddress, directoryLock);
     
     if (!aDirectory)
         return 0;
@@ -3467,6 +5356,12 @@ int Engine::appendToNetWorkNamespace(const std::string & address, const std::str
     if (aDirectory == accessApplicationLocalDirectory)
         return 0;
     
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_devicesMutex);
+        
+        anApplication = accessApplication(anAddress.getDirectory());
+    }
+    
     // create a proxy data
     v = TTValue(anAddress, TTSymbol(service));
     if (!anApplication.send("ProxyDataInstantiate", v, out)) {
@@ -3496,6 +5391,8 @@ int Engine::appendToNetWorkNamespace(const std::string & address, const std::str
         
         anObject.send("Init");
         
+        invalidateAttributeCache(AddressTable::getInstance().intern(anAddress));
+        
         return 1;
     }
     
@@ -3505,12 +5402,13 @@ int Engine::appendToNetWorkNamespace(const std::string & address, const std::str
 int Engine::removeFromNetWorkNamespace(const std::string & address)
 {
     TTAddress           anAddress = toTTAddress(address);
+    std::unique_lock<std::recursive_mutex> directoryLock;
     TTNodeDirectoryPtr  aDirectory;
     TTNodePtr           aNode;
     TTObject            anObject;
     
-    // get the application directory
-    aDirectory = accessApplicationDirectoryFrom(anAddress);
+    // get the application directory (fails while the namespace of the device is being rebuilt)
+    aDirectory = tryLockDirectory(anAddress, directoryLock);
     
     if (!aDirectory)
         return 0;
@@ -3521,6 +5419,9 @@ int Engine::removeFromNetWorkNamespace(const std::string & address)
         
         aDirectory->TTNodeRemove(anAddress);
         
+        // the nodes below are removed too
+        invalidateAttributeCache();
+        
         return 1;
     }
     
@@ -3532,7 +5433,25 @@ int Engine::removeFromNetWorkNamespace(const std::string & address)
 
 int Engine::store(std::string filepath)
 {
-    TTValue v, none;
+    TTValue                                             v, none;
+    std::vector<std::string>                            deviceNames;
+    std::vector<std::unique_lock<std::recursive_mutex> > directoryLocks;
+    
+    // the namespaces are written too : the storage fails rather than waiting for a device which is answering a rebuild
+    getNetworkDevicesName(deviceNames);
+    
+    for (std::vector<std::string>::iterator it = deviceNames.begin(); it != deviceNames.end(); it++) {
+        
+        directoryLocks.push_back(std::unique_lock<std::recursive_mutex>(directoryMutex(*it), std::try_to_lock));
+        
+        if (!directoryLocks.back().owns_lock()) {
+            
+            TTLogMessage("Engine::store : the namespace of %s is being rebuilt\n", it->c_str());
+            return 0;
+        }
+    }
+    
+    std::lock_guard<std::recursive_mutex> lock(m_devicesMutex);
     
     m_lastProjectFilePath = TTSymbol(filepath);
     
@@ -3551,8 +5470,18 @@ int Engine::store(std::string filepath)
 
 int Engine::load(std::string filepath)
 {
-    TTValue out;
-    TTErr   err;
+    TTValue                                             out;
+    TTErr                                               err;
+    std::vector<std::string>                            deviceNames;
+    std::vector<std::unique_lock<std::recursive_mutex> > directoryLocks;
+    
+    // the applications are replaced : wait for the rebuilds of the current devices to end
+    getNetworkDevicesName(deviceNames);
+    
+    for (std::vector<std::string>::iterator it = deviceNames.begin(); it != deviceNames.end(); it++)
+        directoryLocks.push_back(std::unique_lock<std::recursive_mutex>(directoryMutex(*it)));
+    
+    std::lock_guard<std::recursive_mutex> lock(m_devicesMutex);
     
     // Check that all Engine caches have been properly cleared before
     if (m_timeBoxMap.size() > 1)
@@ -3568,6 +5497,8 @@ int Engine::load(std::string filepath)
         TTLogMessage("Engine::load : m_timeConditionMap not empty before the loading\n");
     
     m_lastProjectFilePath = TTSymbol(filepath);
+    m_namespaceCacheHashes.clear();
+    invalidateAttributeCache();
     
     // Create a TTXmlHandler
     TTObject aXmlHandler(kTTSym_XmlHandler);
@@ -3578,6 +5509,19 @@ int Engine::load(std::string filepath)
     
     if (!err) {
         
+        std::vector<std::string> loadedDeviceNames;
+        
+        // the loaded devices cache the same attributes as the added ones
+        getNetworkDevicesName(loadedDeviceNames);
+        
+        for (std::vector<std::string>::iterator it = loadedDeviceNames.begin(); it != loadedDeviceNames.end(); it++) {
+            
+            TTObject anApplication = accessApplication(TTSymbol(*it));
+            
+            if (anApplication.valid())
+                setCachedAttributes(anApplication);
+        }
+        
         // Read the file to setup m_mainScenario
         aXmlHandler.set(kTTSym_object, m_mainScenario);
         err = aXmlHandler.send(kTTSym_Read, m_lastProjectFilePath, out);
@@ -3585,13 +5529,13 @@ int Engine::load(std::string filepath)
         if (!err) {
             
             // Rebuild all the EngineCacheMaps from the main scenario content
-            buildEngineCaches(m_mainScenario, kTTAdrsRoot);
+            buildEngineCaches(m_mainScenario, kTTAdrsRoot, ROOT_BOX_ID);
             
             // BACKWARD COMPATIBILITY : add subScenario if there is not
             for (EngineCacheMapIterator it = m_timeBoxMap.begin(); it != m_timeBoxMap.end(); ++it)
             {
-                TTObject mainProcess = it->second->object;
-                if (it->second->subScenario == NULL)
+                TTObject mainProcess = it->object;
+                if (it->subScenario == NULL)
                 {
                     TTObject start, end;
                 
@@ -3606,7 +5550,7 @@ int Engine::load(std::string filepath)
                     // set sub scenario rigid
                     subScenario.set("rigid", true);
                 
-                    it->second->subScenario = subScenario;
+                    it->subScenario = subScenario;
                 }
             }
         }
@@ -3615,10 +5559,11 @@ int Engine::load(std::string filepath)
     return err == kTTErrNone;
 }
 
-void Engine::buildEngineCaches(TTObject& scenario, TTAddress& scenarioAddress)
+void Engine::buildEngineCaches(TTObject& scenario, TTAddress& scenarioAddress, TimeBoxId scenarioId)
 {
     TTValue             v, objects, none;
     TTObject            timeProcess;
+    std::vector<IntervalId> intervalsId;
     TTObject            timeCondition;
     TTObject            empty;
     TimeBoxId           boxId;
@@ -3641,7 +5586,7 @@ void Engine::buildEngineCaches(TTObject& scenario, TTAddress& scenarioAddress)
         if (v.size() >= 2)
         {
             // get a unique ID for the condition
-            timeConditionId = m_nextConditionedTimeBoxId++;
+            timeConditionId = reserveConditionId();
 
             // cache it but don't register it
             cacheTimeCondition(timeConditionId, timeCondition);
@@ -3678,7 +5623,7 @@ void Engine::buildEngineCaches(TTObject& scenario, TTAddress& scenarioAddress)
             
             // cache it and get an unique id for this process
             TTAddress address = scenarioAddress.appendAddress(TTAddress(name));
-            boxId = cacheTimeBox(timeProcess, address, empty);
+            boxId = cacheTimeBox(timeProcess, address, empty, scenarioId);
             
             // look at events to handle conditions
             buildConditionedTimeBoxCache(boxId, startEvent, endEvent, TTCondToID);
@@ -3688,7 +5633,8 @@ void Engine::buildEngineCaches(TTObject& scenario, TTAddress& scenarioAddress)
         else if (timeProcess.name() == TTSymbol("Interval"))
         {
             // cache it and get an unique id for this process
-            relationId = cacheInterval(timeProcess);
+            relationId = cacheInterval(timeProcess, scenarioId);
+            intervalsId.push_back(relationId);
         }
         
         // for each Scenario process
@@ -3701,16 +5647,16 @@ void Engine::buildEngineCaches(TTObject& scenario, TTAddress& scenarioAddress)
             TTObject endSubScenario;
             timeProcess.get("endEvent", endSubScenario);
             
-            // retreive the time process with the same end and start events
-            EngineCacheMapIterator it;
+            // retreive the time process with the same end and start events (it is one of the scenario children)
+            std::vector<TimeBoxId> siblingsId;
+            TimeBoxId subScenarioId = NO_ID;
             TTAddress address;
             
-            for (it = m_timeBoxMap.begin(); it != m_timeBoxMap.end(); ++it)
+            getChildrenId(scenarioId, siblingsId);
+            
+            for (std::vector<TimeBoxId>::iterator it = siblingsId.begin(); it != siblingsId.end(); ++it)
             {
-                TTObject mainProcess = it->second->object;
-                if (it->second->loop.valid())
-                    mainProcess = it->second->loop;
-                
+                TTObject mainProcess = getMainProcess(*it);
                 TTObject start, end;
                 
                 mainProcess.get("startEvent", start);
@@ -3719,14 +5665,15 @@ void Engine::buildEngineCaches(TTObject& scenario, TTAddress& scenarioAddress)
                 // set the scenario as the subScenario related to this time process
                 if (start == startSubScenario && end == endSubScenario)
                 {
-                    it->second->subScenario = timeProcess;
-                    address = it->second->address;
+                    getSubScenario(*it) = timeProcess;
+                    address = getAddress(*it);
+                    subScenarioId = *it;
                     break;
                 }
             }
             
             // Rebuild all the EngineCacheMaps from the sub scenario content
-            buildEngineCaches(timeProcess, address);
+            buildEngineCaches(timeProcess, address, subScenarioId);
         }
         
         // for each Loop process
@@ -3764,7 +5711,7 @@ void Engine::buildEngineCaches(TTObject& scenario, TTAddress& scenarioAddress)
             
             // cache automation and subScenario and get an unique id for this process
             TTAddress address = scenarioAddress.appendAddress(TTAddress(name));
-            boxId = cacheTimeBox(automation, address, subScenario);
+            boxId = cacheTimeBox(automation, address, subScenario, scenarioId);
             
             // cache the loop
             setLoop(boxId, timeProcess);
@@ -3773,7 +5720,38 @@ void Engine::buildEngineCaches(TTObject& scenario, TTAddress& scenarioAddress)
             buildConditionedTimeBoxCache(boxId, startLoop, endLoop, TTCondToID);
             
             // rebuild all the EngineCacheMaps from the sub scenario content
-            buildEngineCaches(subScenario, address);
+            buildEngineCaches(subScenario, address, boxId);
+        }
+    }
+    
+    // link the intervals to the boxes they relate now that all the boxes of the scenario are cached
+    if (!intervalsId.empty())
+    {
+        std::map<TTObjectBasePtr, TimeBoxId> eventsBox;
+        std::vector<TimeBoxId> childrenId;
+        
+        getChildrenId(scenarioId, childrenId);
+        
+        for (std::vector<TimeBoxId>::iterator it = childrenId.begin(); it != childrenId.end(); ++it)
+        {
+            TTObject mainProcess = getMainProcess(*it);
+            TTObject start, end;
+            
+            mainProcess.get("startEvent", start);
+            mainProcess.get("endEvent", end);
+            
+            eventsBox[start.instance()] = *it;
+            eventsBox[end.instance()] = *it;
+        }
+        
+        for (std::vector<IntervalId>::iterator it = intervalsId.begin(); it != intervalsId.end(); ++it)
+        {
+            TTObject start, end;
+            
+            getInterval(*it).get("startEvent", start);
+            getInterval(*it).get("endEvent", end);
+            
+            linkInterval(*it, eventsBox[start.instance()], eventsBox[end.instance()]);
         }
     }
 }
@@ -3887,71 +5865,37 @@ void TimeEventStatusAttributeCallback(const TTValue& baton, const TTValue& value
 {
     EnginePtr               engine;
     ConditionedTimeBoxId    triggerId;
-    TTObject                event, condition;
+    TTObject                event;
     TTValue                 v;
     TTSymbol                status;
-    TTBoolean               ready;
 	
 	// unpack baton (engine, triggerId)
 	engine = EnginePtr((TTPtr)baton[0]);
     triggerId = ConditionedTimeBoxId(baton[1]);
-	
-	// Unpack data (event)
-	event = value[0];
-    
-    // get status
-    event.get("status", v);
-    status = v[0];
-    
-    // get event condition
-    event.get("condition", v);
-    condition = v[0];
     
-    if (condition.valid()) {
+    // the status and the condition ready state are read when the GUI thread processes the notification
+    engine->pushExecutionEvent(ExecutionEvent::TriggerStatus, triggerId);
     
-        // get condition ready state
-        condition.get("ready", ready);
+    iscoreEngineDebug {
         
-        iscoreEngineDebug {
-            
-            if (ready)
-                TTLogMessage("TriggerPoint %ld is part of a ready condition\n", triggerId);
-            else
-                TTLogMessage("TriggerPoint %ld is part of a none ready condition\n", triggerId);
-        }
-    }
-    else
-        ready = true;
-    
-    if (engine->m_TimeEventStatusAttributeCallback != nullptr) {
+        // Unpack data (event)
+        event = value[0];
+        
+        // get status
+        event.get("status", v);
+        status = v[0];
         
         if (status == kTTSym_eventWaiting) {
-            engine->m_TimeEventStatusAttributeCallback(triggerId, false);
+            TTLogMessage("TriggerPoint %ld is waiting\n", triggerId);
         }
         else if (status == kTTSym_eventPending) {
-            engine->m_TimeEventStatusAttributeCallback(triggerId, ready);
+            TTLogMessage("TriggerPoint %ld is pending\n", triggerId);
         }
         else if (status == kTTSym_eventHappened) {
-            engine->m_TimeEventStatusAttributeCallback(triggerId, false);
+            TTLogMessage("TriggerPoint %ld happened\n", triggerId);
         }
         else if (status == kTTSym_eventDisposed) {
-            engine->m_TimeEventStatusAttributeCallback(triggerId, false);
-        }
-        
-        iscoreEngineDebug {
-            
-            if (status == kTTSym_eventWaiting) {
-                TTLogMessage("TriggerPoint %ld is waiting\n", triggerId);
-            }
-            else if (status == kTTSym_eventPending) {
-                TTLogMessage("TriggerPoint %ld is pending\n", triggerId);
-            }
-            else if (status == kTTSym_eventHappened) {
-                TTLogMessage("TriggerPoint %ld happened\n", triggerId);
-            }
-            else if (status == kTTSym_eventDisposed) {
-                TTLogMessage("TriggerPoint %ld is disposed\n", triggerId);
-            }
+            TTLogMessage("TriggerPoint %ld is disposed\n", triggerId);
         }
     }
 }
@@ -3972,7 +5916,7 @@ void TimeConditionReadyAttributeCallback(const TTValue& baton, const TTValue& va
         for (TTUInt32 i = 1; i < baton.size(); i++)
         {
             triggerId = ConditionedTimeBoxId(baton[i]);
-            engine->m_TimeEventStatusAttributeCallback(triggerId, ready);
+            engine->pushExecutionEvent(ExecutionEvent::TriggerReady, triggerId, ready);
             
             iscoreEngineDebug {
                 
@@ -3996,9 +5940,10 @@ void AutomationStartCallback(const TTValue& baton, const TTValue& /*value*/)
     
     iscoreEngineDebug 
         TTLogMessage("Box %ld starts at %ld ms\n", boxId-1, engine->getCurrentExecutionDate());
-        
-    if (engine->m_TimeProcessSchedulerRunningAttributeCallback != nullptr)
-        engine->m_TimeProcessSchedulerRunningAttributeCallback(boxId, YES);
+    
+    // queue the notification before to publish the position : a box is never seen ended before its notification is queued
+    engine->pushExecutionEvent(ExecutionEvent::BoxRunning, boxId, YES);
+    engine->setExecutionBoxRunning(boxId, YES);
 
 }
 
@@ -4015,8 +5960,24 @@ void AutomationEndCallback(const TTValue& baton, const TTValue& /*value*/)
         TTLogMessage("Box %ld ends at %ld ms\n", boxId-1, engine->getCurrentExecutionDate());
     
     // update all process running state too
-    if (engine->m_TimeProcessSchedulerRunningAttributeCallback != nullptr)
-        engine->m_TimeProcessSchedulerRunningAttributeCallback(boxId, NO);
+    engine->pushExecutionEvent(ExecutionEvent::BoxRunning, boxId, NO);
+    engine->setExecutionBoxRunning(boxId, NO);
+}
+
+void TransportDataValueCallback(const TTValue& baton, const TTValue& value)
+{
+    EnginePtr   engine;
+    TTSymbol    transport;
+	
+	// unpack baton (engine, transport feature)
+	engine = EnginePtr((TTPtr)baton[0]);
+    transport = baton[1];
+    
+    iscoreEngineDebug
+        TTLogMessage("Transport %s received\n", transport.c_str());
+    
+    if (engine->m_TransportDataValueCallback != nullptr)
+        engine->m_TransportDataValueCallback(transport, value);
 }
 
 void NamespaceCallback(const TTValue& baton, const TTValue& value)
@@ -4032,34 +5993,23 @@ void NamespaceCallback(const TTValue& baton, const TTValue& value)
     // Unpack value (anAddress, aNode, flag, anObserver)
 	flag = value[2];
     
-    if (flag == kAddressCreated)
+    if (flag == kAddressCreated) {
+        
+        engine->invalidateAttributeCache();
         engine->m_NetworkDeviceNamespaceCallback(applicationName);
+    }
 }
 
 TTAddress Engine::toTTAddress(string networktreeAddress)
 {
-    TTSymbol            temp(networktreeAddress);
-    TTAddress           address(temp);
-    TTAddress           applicationName, anAddress;
-    TTString            s;
-    
-    // split the address to get application name and then an address
-    address.splitAt(0, applicationName, anAddress);
-    
-    // edit applicationName:/anAddress
-    s = applicationName.string();
-    s += S_DIRECTORY.string();
-    
-    if (anAddress != kTTAdrsEmpty)
-        s += anAddress.string();
+    AddressTable& table = AddressTable::getInstance();
     
-    return TTAddress(s);
+    return table.ttAddress(table.intern(networktreeAddress));
 }
 
 std::string Engine::toNetworkTreeAddress(TTAddress aTTAddress)
 {
-    std::string s = aTTAddress.getDirectory().string().c_str();
-    s += aTTAddress.normalize().string();
+    AddressTable& table = AddressTable::getInstance();
     
-    return s;
+    return table.address(table.intern(aTTAddress));
 }
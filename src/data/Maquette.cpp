@@ -98,14 +98,14 @@ Maquette::init()
         
     _engines = new Engine(&triggerPointIsActiveCallback, &boxIsRunningCallback, &transportCallback, &deviceCallback, &deviceConnectionErrorCallback, jamomaFolder);
 	
-	connect(this, SIGNAL(boxIsRunningSignal(uint,bool)),
-			this, SLOT(boxIsRunningSlot(uint,bool)), Qt::QueuedConnection);
-	connect(this, SIGNAL(triggerPointIsActiveSignal(uint,bool)),
-			this, SLOT(updateTriggerPointActiveStatus(uint,bool)), Qt::QueuedConnection);
 	connect(this, SIGNAL(playOrResumeSignal()),
 			_scene, SLOT(playOrResume()), Qt::QueuedConnection);
 	connect(this, SIGNAL(stopOrPauseSignal()),
 			_scene, SLOT(stopOrPause()), Qt::QueuedConnection);
+	connect(this, SIGNAL(pauseOrResumeSignal()),
+			_scene, SLOT(pauseOrResume()), Qt::QueuedConnection);
+	connect(this, SIGNAL(rewindSignal()),
+			_scene, SLOT(stopAndGoToStart()), Qt::QueuedConnection);
 	connect(this, SIGNAL(changeTimeOffsetSignal(uint)),
 			_scene, SLOT(changeTimeOffset(uint)), Qt::QueuedConnection);
 	connect(this, SIGNAL(changeSpeedSignal(double)),
@@ -245,7 +245,7 @@ Maquette::parentBoxes()
 unsigned int
 Maquette::nextBoxNumber()
 {
-  return _engines->getNextTimeBoxId()-1; // -1 because the main scenario is at 1 so the first box is at 2
+  return _engines->getNextTimeBoxNumber();
 }
 
 /// \todo change arguments named corner. this is not comprehensible. (par jaime Chao)
@@ -328,9 +328,15 @@ Maquette::requestNetworkNamespace(const string &address, string &nodeType, vecto
   return _engines->requestNetworkNamespace(address, nodeType, nodes, leaves, attributes, attributesValue);
 }
 
-void
+int
+Maquette::requestNetworkNamespaceDump(const string &address, NamespaceNodes &dump, bool recursive)
+{
+  return _engines->requestNetworkNamespaceDump(address, dump, recursive);
+}
+
+bool
 Maquette::rebuildNetworkNamespace(const std::string &application){
-    _engines->rebuildNetworkNamespace(application);
+    return _engines->rebuildNetworkNamespace(application);
 }
 
 void
@@ -374,6 +380,12 @@ vector<string> Maquette::requestNetworkSnapShot(const string &address)
   return _engines->requestNetworkSnapShot(address);
 }
 
+void
+Maquette::requestNetworkSnapShot(const vector<AddressId> &addresses, StateLines &snapshot, bool recursive)
+{
+  _engines->requestNetworkSnapShot(addresses, snapshot, recursive);
+}
+
 vector<string>
 Maquette::firstMessagesToSend(unsigned int boxID)
 {
@@ -399,131 +411,118 @@ Maquette::lastMessagesToSend(unsigned int boxID)
   return messages;
 }
 
-void
-Maquette::updateCurves(unsigned int boxID, const vector<string> &startMsgs, const vector<string> &endMsgs)
+/*!
+ * \brief Builds the state line of a message : the address is interned and only the value is parsed.
+ */
+static StateLine
+stateLine(NetworkMessages *messages, const Message &msg)
 {
-  //QMap<address,value>
-  QMap<string, string> startMessages;
-  QMap<string, string> endMessages;
-  vector<string> curvesAddresses = getCurvesAddresses(boxID);
-
-  vector<string>::const_iterator it;
-  string currentMsg;
-  string currentAddress;
-  string currentValue;
-
-  /************  init start messages (QMap)  ************/
-  for (it = startMsgs.begin(); it != startMsgs.end(); ++it) {
-      size_t blankPos;
-      currentMsg = *it;
-      if ((blankPos = it->find_first_of(" ")) != string::npos) {
-          currentAddress = currentMsg.substr(0, blankPos);
-          if (blankPos != currentMsg.size()) {
-              currentValue = currentMsg.substr(blankPos + 1, currentMsg.size());
-            }
-        }
-      startMessages.insert(currentAddress, currentValue);
-    }
+  StateLine line(messages->addressId(msg));
 
-  /************  init end messages (QMap)  ************/
-  for (it = endMsgs.begin(); it != endMsgs.end(); ++it) {
-      size_t blankPos;
-      currentMsg = *it;
-      if ((blankPos = it->find_first_of(" ")) != string::npos) {
-          currentAddress = currentMsg.substr(0, blankPos);
-          if (blankPos != currentMsg.size()) {
-              currentValue = currentMsg.substr(blankPos + 1, currentMsg.size());
-            }
-        }
-      endMessages.insert(currentAddress, currentValue);
-      std::cout<<"Insert "<<currentAddress<<std::endl;
+  if (!msg.value.isEmpty()) {
+      line.value = TTValue(TTString(msg.value.toStdString()));
+      line.value.fromString();
     }
 
+  return line;
+}
 
+/*!
+ * \brief Builds the state of all the messages in the order of their items.
+ */
+static StateLines
+computeState(NetworkMessages *messages)
+{
+  StateLines state;
+  QList<QTreeWidgetItem *> itemsList = messages->getItems();
 
+  state.reserve(itemsList.size());
+  for (int i = 0; i < itemsList.size(); i++) {
+      state.push_back(stateLine(messages, messages->getMessage(itemsList.at(i))));
+    }
 
-  /************  addCurve if endAddress contains startAddress && endValue != startValue ************/
-  QList<string> startAddresses = startMessages.keys();
-  QList<string>::iterator startAddressIt;
+  return state;
+}
 
-  for (startAddressIt = startAddresses.begin(); startAddressIt != startAddresses.end(); ++startAddressIt) {
-      string address = *startAddressIt;
-      if (endMessages.contains(address)) {
-          if (std::find(curvesAddresses.begin(), curvesAddresses.end(), address) == curvesAddresses.end() && startMessages.value(address) != endMessages.value(address)) {
+void
+Maquette::updateCurves(unsigned int boxID, const StateLines &startState, const StateLines &endState)
+{
+  AddressTable &table = AddressTable::getInstance();
 
-              _engines->addCurve(boxID, address);
-              _engines->setCurveSampleRate(boxID, address, 40);
-              
-              getBox(boxID)->addCurve(address);
-            }
-        }
-      else {
-          if (std::find(curvesAddresses.begin(), curvesAddresses.end(), address) != curvesAddresses.end()) {
+  //QMap<address,value>
+  QMap<AddressId, TTValue> startMessages;
+  QMap<AddressId, TTValue> endMessages;
+  vector<AddressId> curvesAddresses;
+  StateLines::const_iterator lineIt;
 
-              _engines->removeCurve(boxID, address);
+  _engines->getCurvesAddress(boxID, curvesAddresses);
 
-            }
-        }
+  for (lineIt = startState.begin(); lineIt != startState.end(); ++lineIt) {
+      startMessages.insert(lineIt->address, lineIt->value);
+    }
+  for (lineIt = endState.begin(); lineIt != endState.end(); ++lineIt) {
+      endMessages.insert(lineIt->address, lineIt->value);
     }
 
-  /************  addCurve if startAddress contains endAddress && endValue != startValue ************/
-  QList<string> endAddresses = endMessages.keys();
-  QList<string>::iterator endAddressIt;
+  /************  addCurve if both start and end contain the address && endValue != startValue ************/
+  QMap<AddressId, TTValue>::const_iterator msgIt;
 
-  for (endAddressIt = endAddresses.begin(); endAddressIt != endAddresses.end(); ++endAddressIt) {
-      string address = *endAddressIt;
-      if (startMessages.contains(address)) {
-          if (std::find(curvesAddresses.begin(), curvesAddresses.end(), address) == curvesAddresses.end() && startMessages.value(address) != endMessages.value(address)) {
+  for (msgIt = startMessages.begin(); msgIt != startMessages.end(); ++msgIt) {
+      AddressId address = msgIt.key();
+      bool hasCurve = std::find(curvesAddresses.begin(), curvesAddresses.end(), address) != curvesAddresses.end();
+
+      if (endMessages.contains(address)) {
+          if (!hasCurve && !(msgIt.value() == endMessages.value(address))) {
 
               _engines->addCurve(boxID, address);
               _engines->setCurveSampleRate(boxID, address, 40);
-              
-              getBox(boxID)->addCurve(address);
+
+              getBox(boxID)->addCurve(table.address(address));
             }
         }
-      else {
-          if (std::find(curvesAddresses.begin(), curvesAddresses.end(), address) != curvesAddresses.end()) {
+      else if (hasCurve) {
+          _engines->removeCurve(boxID, address);
+        }
+    }
 
-              _engines->removeCurve(boxID, address);
+  /************  removeCurve if only end contains the address ************/
+  for (msgIt = endMessages.begin(); msgIt != endMessages.end(); ++msgIt) {
+      AddressId address = msgIt.key();
 
+      if (!startMessages.contains(address)) {
+          if (std::find(curvesAddresses.begin(), curvesAddresses.end(), address) != curvesAddresses.end()) {
+              _engines->removeCurve(boxID, address);
             }
         }
     }
 
   /************    Pour le cas open file   ************/
-  curvesAddresses = getCurvesAddresses(boxID);
-  for (it = curvesAddresses.begin(); it != curvesAddresses.end(); ++it) {
-      currentMsg = *it;
-      getBox(boxID)->addCurveAddress(currentMsg);
-      if (startMessages.contains(currentMsg)) {
-          startMessages.remove(currentMsg);
-        }
-      if (endMessages.contains(currentMsg)) {
-          endMessages.remove(currentMsg);
-        }
-    }
+  curvesAddresses.clear();
+  _engines->getCurvesAddress(boxID, curvesAddresses);
 
+  vector<AddressId>::const_iterator curveIt;
+  for (curveIt = curvesAddresses.begin(); curveIt != curvesAddresses.end(); ++curveIt) {
+      getBox(boxID)->addCurveAddress(table.address(*curveIt));
+    }
 }
 
 bool
 Maquette::setStartMessagesToSend(unsigned int boxID, NetworkMessages *messages, bool sort)
 {
-    vector<string> firstMsgs;
+    StateLines firstState;
     if(sort){
-        firstMsgs = sortByPriority(messages);
+        firstState = sortByPriority(messages);
     }
     else
-        firstMsgs = messages->computeMessages();
-
-  //sortByPriority(firstMsgs);
+        firstState = computeState(messages);
 
   if (boxID != NO_ID && (getBox(boxID) != nullptr)) {
-      _engines->setCtrlPointMessagesToSend(boxID, BEGIN_CONTROL_POINT_INDEX, firstMsgs);
+      _engines->setCtrlPointState(boxID, BEGIN_CONTROL_POINT_INDEX, firstState);
       _boxes[boxID]->setStartMessages(messages);
 
-      vector<string> lastMsgs;
-      _engines->getCtrlPointMessagesToSend(boxID, END_CONTROL_POINT_INDEX, lastMsgs);
-      updateCurves(boxID, firstMsgs, lastMsgs);
+      StateLines lastState;
+      _engines->getCtrlPointState(boxID, END_CONTROL_POINT_INDEX, lastState);
+      updateCurves(boxID, firstState, lastState);
       return true;
     }
   return false;
@@ -579,9 +578,9 @@ Maquette::compareByPriority(const QPair<QTreeWidgetItem *, std::string> v1, cons
     return priority1 < priority2;
 }
 
-vector<string>
+StateLines
 Maquette::sortByPriority(NetworkMessages *messages){
-    vector<string>                              sortedMessages;
+    StateLines                                  sortedState;
     QPair<QTreeWidgetItem *, std::string>       pair; //<item, absoluteAddress>
     QList<QTreeWidgetItem *>                    itemsList = messages->getItems();
     QList< QPair<QTreeWidgetItem *,string> >    pairsList;
@@ -589,18 +588,19 @@ Maquette::sortByPriority(NetworkMessages *messages){
     //Make pairs list <item, address>
     for(int i=0 ; i<itemsList.size() ; i++)
     {
-        pair = qMakePair( itemsList.at(i), messages->computeMessage(messages->getMessage(itemsList.at(i))));
+        pair = qMakePair( itemsList.at(i), messages->computeMessageWithoutValue(messages->getMessage(itemsList.at(i))));
         pairsList << pair;
     }
 
     //Sort list
     qSort(pairsList.begin(), pairsList.end(), compareByPriority);
 
-    //convert to vector<string>
+    //convert to state
+    sortedState.reserve(pairsList.size());
     for(int i=0 ; i<pairsList.size() ; i++)
-        sortedMessages.push_back(pairsList.at(i).second);
+        sortedState.push_back(stateLine(messages, messages->getMessage(pairsList.at(i).first)));
 
-    return sortedMessages;
+    return sortedState;
 }
 
 bool
@@ -682,20 +682,20 @@ Maquette::endMessages(unsigned int boxID)
 bool
 Maquette::setEndMessagesToSend(unsigned int boxID, NetworkMessages *messages, bool sort)
 {  
-  vector<string> lastMsgs;
+  StateLines lastState;
   if(sort){
-      lastMsgs = sortByPriority(messages);
+      lastState = sortByPriority(messages);
   }
   else
-      lastMsgs = messages->computeMessages();
+      lastState = computeState(messages);
 
   if (boxID != NO_ID && (getBox(boxID) != nullptr)) {
-      _engines->setCtrlPointMessagesToSend(boxID, END_CONTROL_POINT_INDEX, lastMsgs);
+      _engines->setCtrlPointState(boxID, END_CONTROL_POINT_INDEX, lastState);
       _boxes[boxID]->setEndMessages(messages);
 
-      vector<string> firstMsgs;
-      _engines->getCtrlPointMessagesToSend(boxID, BEGIN_CONTROL_POINT_INDEX, firstMsgs);
-      updateCurves(boxID, firstMsgs, lastMsgs);
+      StateLines firstState;
+      _engines->getCtrlPointState(boxID, BEGIN_CONTROL_POINT_INDEX, firstState);
+      updateCurves(boxID, firstState, lastState);
 
       return true;
     }
@@ -778,8 +778,8 @@ Maquette::updateBox(unsigned int boxID, const Coords &coord)
 {
     //  std::cout<<"--- updateBox ---"<<std::endl;
     bool moveAccepted = false;
-    vector<unsigned int> moved;
-    vector<unsigned int>::iterator it;
+    MovedTimeBoxes moved;
+    MovedTimeBoxes::iterator it;
     int boxBeginTime;
     if (boxID != NO_ID && boxID != ROOT_BOX_ID) {
         BasicBox *box = _boxes[boxID];
@@ -815,21 +815,22 @@ Maquette::updateBox(unsigned int boxID, const Coords &coord)
 
 
   if (moveAccepted) {
+      // the Engine only returns the boxes whose dates have changed with their new dates
       for (it = moved.begin(); it != moved.end(); it++) {
 #ifdef DEBUG
-          std::cerr << "Maquette::updateBoxes : box moved : " << *it << std::endl;
+          std::cerr << "Maquette::updateBoxes : box moved : " << it->id << std::endl;
 #endif
-          if(_boxes[*it]->ID() != boxID){
-          if ((_boxes[*it]->relativeBeginPos() != _engines->getBoxBeginTime(*it) / MaquetteScene::MS_PER_PIXEL ||
-               (_engines->getBoxEndTime(*it) / MaquetteScene::MS_PER_PIXEL - _engines->getBoxBeginTime(*it) / MaquetteScene::MS_PER_PIXEL) != _boxes[*it]->width()) && _engines->getBoxBeginTime(*it)) {
+          if(it->id != boxID){
+          if ((_boxes[it->id]->relativeBeginPos() != it->start / MaquetteScene::MS_PER_PIXEL ||
+               (it->end / MaquetteScene::MS_PER_PIXEL - it->start / MaquetteScene::MS_PER_PIXEL) != _boxes[it->id]->width()) && it->start) {
 
-              boxBeginTime = (_engines->getBoxBeginTime(*it) / MaquetteScene::MS_PER_PIXEL);
-              _boxes[*it]->setRelativeTopLeft(QPoint(boxBeginTime , _boxes[*it]->getTopLeft().y()));
-              _boxes[*it]->setSize(QPoint((_engines->getBoxEndTime(*it) / MaquetteScene::MS_PER_PIXEL -
+              boxBeginTime = (it->start / MaquetteScene::MS_PER_PIXEL);
+              _boxes[it->id]->setRelativeTopLeft(QPoint(boxBeginTime , _boxes[it->id]->getTopLeft().y()));
+              _boxes[it->id]->setSize(QPoint((it->end / MaquetteScene::MS_PER_PIXEL -
                                            boxBeginTime),
-                                          _boxes[*it]->getSize().y()));
-              _boxes[*it]->setPos(_boxes[*it]->getCenter());
-              _boxes[*it]->update();
+                                          _boxes[it->id]->getSize().y()));
+              _boxes[it->id]->setPos(_boxes[it->id]->getCenter());
+              _boxes[it->id]->update();
 
 //              std::cout<<"i-score : BOX"<< _boxes[*it]->ID()<<" "<<boxBeginTime<<" ------ OK"<<std::endl;
 //              std::cout<<"other boxes ("<<_boxes[*it]->ID()<<" "<<_engines->getBoxBeginTime(*it)<<" "<<_engines->getBoxEndTime(*it) - _engines->getBoxBeginTime(*it)<<")"<<std::endl;
@@ -844,19 +845,32 @@ Maquette::updateBox(unsigned int boxID, const Coords &coord)
 bool
 Maquette::updateBoxes(const map<unsigned int, Coords> &boxes)
 {
-  bool moveAccepted{};
-  vector<unsigned int> moved;
+  unsigned int nbEdited = 0;
+  MovedTimeBoxes moved;
+  vector<unsigned int> refused;
   map<unsigned int, Coords >::const_iterator it;
-  vector<unsigned int>::iterator it2;
+
+  // queue all the moves to let the Engines solve them at once
+  _engines->beginEdit();
+  for (it = boxes.begin(); it != boxes.end(); it++) {
+      if (it->first != NO_ID && it->first != ROOT_BOX_ID) {
+          _engines->performBoxEditing(it->first, it->second.topLeftX * MaquetteScene::MS_PER_PIXEL,
+                                      it->second.topLeftX * MaquetteScene::MS_PER_PIXEL +
+                                      it->second.sizeX * MaquetteScene::MS_PER_PIXEL, moved);
+          nbEdited++;
+        }
+    }
+  _engines->commitEdit(moved, refused);
+
   for (it = boxes.begin(); it != boxes.end(); it++) {
       if (it->first != NO_ID && it->first != ROOT_BOX_ID) {
           BasicBox *curBox = _boxes[it->first];
-          if ((moveAccepted = _engines->performBoxEditing(it->first, it->second.topLeftX * MaquetteScene::MS_PER_PIXEL,
-                                                         it->second.topLeftX * MaquetteScene::MS_PER_PIXEL +
-                                                         it->second.sizeX * MaquetteScene::MS_PER_PIXEL, moved))) {
+          if (std::find(refused.begin(), refused.end(), it->first) == refused.end()) {
+              _engines->setBoxVerticalPosition(it->first, it->second.topLeftY);
+              _engines->setBoxVerticalSize(it->first, it->second.sizeY);
               curBox->setRelativeTopLeft(QPoint(it->second.topLeftX, it->second.topLeftY));
               curBox->setSize(QPoint(it->second.sizeX, it->second.sizeY));
-              curBox->setPos(_boxes[it->first]->getCenter());
+              curBox->setPos(curBox->getCenter());
               curBox->update();
             }
           else {
@@ -874,24 +888,10 @@ Maquette::updateBoxes(const map<unsigned int, Coords> &boxes)
         }
     }
 
-  if (moveAccepted) {
-      for (it2 = moved.begin(); it2 != moved.end(); it2++) {
-#ifdef DEBUG
-          std::cerr << "Maquette::updateBoxes : box moved : " << *it2 << std::endl;
-#endif
-          if (_boxes[*it2]->relativeBeginPos() != _engines->getBoxBeginTime(*it2) / MaquetteScene::MS_PER_PIXEL ||
-              (_engines->getBoxEndTime(*it2) / MaquetteScene::MS_PER_PIXEL - _engines->getBoxBeginTime(*it2) / MaquetteScene::MS_PER_PIXEL) != _boxes[*it2]->width()) {
-              _boxes[*it2]->setRelativeTopLeft(QPoint(_engines->getBoxBeginTime(*it2) / MaquetteScene::MS_PER_PIXEL,
-                                                      _boxes[*it2]->getTopLeft().y()));
-              _boxes[*it2]->setSize(QPoint((_engines->getBoxEndTime(*it2) / MaquetteScene::MS_PER_PIXEL -
-                                            _engines->getBoxBeginTime(*it2) / MaquetteScene::MS_PER_PIXEL),
-                                           _boxes[*it2]->getSize().y()));
-              _boxes[*it2]->setPos(_boxes[*it2]->getCenter());
-              _boxes[*it2]->update();
-            }
-        }
-    }
-  return moveAccepted;
+  // update the other boxes moved by the edition
+  updateBoxesFromEngines(moved);
+
+  return refused.size() < nbEdited;
 }
 
 void
@@ -1213,14 +1213,18 @@ Maquette::setCurveSections(unsigned int boxID, const string &address, unsigned i
 
 bool
 Maquette::getCurveAttributes(unsigned int boxID, const std::string &address, unsigned int argPosition,
-                             unsigned int &sampleRate, bool &redundancy, bool &interpolate, vector<float>& values, vector<string> &/*argTypes*/,
+                             unsigned int &sampleRate, bool &redundancy, bool &interpolate, CurveSamples& values, vector<string> &/*argTypes*/,
                              vector<float> &xPercents, vector<float> &yValues, vector<short> &sectionType, vector<float> &coeff)
 {
-  if (_engines->getCurveValues(boxID, address, argPosition, values)) {
-      if (_engines->getCurveSections(boxID, address, argPosition, xPercents, yValues, sectionType, coeff)) {
-          sampleRate = _engines->getCurveSampleRate(boxID, address);
-          redundancy = _engines->getCurveRedundancy(boxID, address);
-          interpolate = !_engines->getCurveMuteState(boxID, address);
+  AddressId addressId = AddressTable::getInstance().intern(address);
+
+  values.reset();
+
+  if (_engines->getCurveValues(boxID, addressId, argPosition, values)) {
+      if (_engines->getCurveSections(boxID, addressId, argPosition, xPercents, yValues, sectionType, coeff)) {
+          sampleRate = _engines->getCurveSampleRate(boxID, addressId);
+          redundancy = _engines->getCurveRedundancy(boxID, addressId);
+          interpolate = !_engines->getCurveMuteState(boxID, addressId);
           return true;
         }     
     }
@@ -1234,27 +1238,46 @@ Maquette::getCurveValues(unsigned int boxID, const std::string &address, unsigne
     return _engines->getCurveValues(boxID,address,argPosition,values);
 }
 
+bool
+Maquette::getCurveValues(unsigned int boxID, const std::string &address, unsigned int argPosition, CurveSamples &values)
+{
+    return _engines->getCurveValues(boxID, AddressTable::getInstance().intern(address), argPosition, values);
+}
+
+bool
+Maquette::sampleCurveSections(const vector<float> &xPercents, const vector<float> &yValues, const vector<float> &coeff,
+                              unsigned int nbSamples, vector<float> &values)
+{
+    return _engines->sampleCurveSections(xPercents, yValues, coeff, nbSamples, values);
+}
+
 void
 Maquette::updateBoxesAttributes(){
     _scene->updateBoxesWidgets();
 }
 
 void
-Maquette::updateBoxesFromEngines(const vector<unsigned int> &movedBoxes)
+Maquette::updateBoxesFromEngines(const MovedTimeBoxes &movedBoxes)
 {
-  vector<unsigned int>::const_iterator it;
-  if (!movedBoxes.empty()) {
-      for (it = movedBoxes.begin(); it != movedBoxes.end(); it++) {
-          if ((_boxes[*it]->relativeBeginPos() != _engines->getBoxBeginTime(*it) / MaquetteScene::MS_PER_PIXEL ||
-               (_engines->getBoxEndTime(*it) / MaquetteScene::MS_PER_PIXEL - _engines->getBoxBeginTime(*it) / MaquetteScene::MS_PER_PIXEL) != _boxes[*it]->width())) {
-              _boxes[*it]->setRelativeTopLeft(QPoint(_engines->getBoxBeginTime(*it) / MaquetteScene::MS_PER_PIXEL,
-                                                     _boxes[*it]->getTopLeft().y()));
-              _boxes[*it]->setSize(QPoint((_engines->getBoxEndTime(*it) / MaquetteScene::MS_PER_PIXEL -
-                                           _engines->getBoxBeginTime(*it) / MaquetteScene::MS_PER_PIXEL),
-                                          _boxes[*it]->getSize().y()));
-              _boxes[*it]->setPos(_boxes[*it]->getCenter());
-              _boxes[*it]->update();
-            }
+  MovedTimeBoxes::const_iterator it;
+  BoxesMap::iterator boxIt;
+  for (it = movedBoxes.begin(); it != movedBoxes.end(); it++) {
+#ifdef DEBUG
+      std::cerr << "Maquette::updateBoxesFromEngines : box moved : " << it->id << std::endl;
+#endif
+      if ((boxIt = _boxes.find(it->id)) == _boxes.end()) {
+          continue;
+        }
+      BasicBox *box = boxIt->second;
+      if ((box->relativeBeginPos() != it->start / MaquetteScene::MS_PER_PIXEL ||
+           (it->end / MaquetteScene::MS_PER_PIXEL - it->start / MaquetteScene::MS_PER_PIXEL) != box->width())) {
+          box->setRelativeTopLeft(QPoint(it->start / MaquetteScene::MS_PER_PIXEL,
+                                         box->getTopLeft().y()));
+          box->setSize(QPoint((it->end / MaquetteScene::MS_PER_PIXEL -
+                               it->start / MaquetteScene::MS_PER_PIXEL),
+                              box->getSize().y()));
+          box->setPos(box->getCenter());
+          box->update();
         }
     }
 }
@@ -1262,21 +1285,30 @@ Maquette::updateBoxesFromEngines(const vector<unsigned int> &movedBoxes)
 void
 Maquette::updateBoxesFromEngines()
 {
-  BoxesMap::iterator it;
-  for (it = _boxes.begin(); it != _boxes.end(); ++it) {
-      if(it->first == ROOT_BOX_ID){
-          _scene->view()->resetCachedContent();
-      }
-      else{
-          it->second->setRelativeTopLeft(QPoint(_engines->getBoxBeginTime(it->first) / MaquetteScene::MS_PER_PIXEL,
-                                                it->second->getTopLeft().y()));
-          it->second->setSize(QPoint((_engines->getBoxEndTime(it->first) / MaquetteScene::MS_PER_PIXEL -
-                                      _engines->getBoxBeginTime(it->first) / MaquetteScene::MS_PER_PIXEL),
-                                     it->second->getSize().y()));
-          it->second->setPos(it->second->getCenter());
-          it->second->centerWidget();
-          it->second->update();
-      }
+  MovedTimeBoxes dates;
+  MovedTimeBoxes::iterator it;
+  BoxesMap::iterator boxIt;
+
+  if (_boxes.find(ROOT_BOX_ID) != _boxes.end()) {
+      _scene->view()->resetCachedContent();
+    }
+
+  // get the dates of all boxes in one call
+  _engines->getBoxesDates(dates);
+
+  for (it = dates.begin(); it != dates.end(); ++it) {
+      if ((boxIt = _boxes.find(it->id)) == _boxes.end()) {
+          continue;
+        }
+      BasicBox *box = boxIt->second;
+      box->setRelativeTopLeft(QPoint(it->start / MaquetteScene::MS_PER_PIXEL,
+                                     box->getTopLeft().y()));
+      box->setSize(QPoint((it->end / MaquetteScene::MS_PER_PIXEL -
+                           it->start / MaquetteScene::MS_PER_PIXEL),
+                          box->getSize().y()));
+      box->setPos(box->getCenter());
+      box->centerWidget();
+      box->update();
     }
 }
 
@@ -1288,7 +1320,7 @@ Maquette::addRelation(unsigned int ID1, BoxExtremity firstExtremum, unsigned int
   if (ID1 == NO_ID || ID2 == NO_ID) {
       return ARGS_ERROR;
     }
-  vector<unsigned int> movedBoxes;
+  MovedTimeBoxes movedBoxes;
   unsigned int controlPointID1 = NO_ID;
   unsigned int controlPointID2 = NO_ID;
   if (firstExtremum == BOX_START) {
@@ -1388,7 +1420,7 @@ Maquette::areRelated(unsigned int ID1, unsigned int ID2)
 void
 Maquette::changeRelationBounds(unsigned int relID, const float &minBound, const float &maxBound)
 {
-  vector<unsigned int> movedBoxes;
+  MovedTimeBoxes movedBoxes;
   int minBoundMS = NO_BOUND;
   if (minBound != NO_BOUND) {
       minBoundMS = minBound * (MaquetteScene::MS_PER_PIXEL * _scene->zoom());
@@ -1419,13 +1451,28 @@ Maquette::duration()
 unsigned int
 Maquette::getCurrentTime() const
 {
-  return _engines->getCurrentExecutionDate();
+  return _engines->getExecutionState().date;
 }
 
 float
 Maquette::getPosition(unsigned int boxID)
 {
-  return (float)_engines->getCurrentExecutionPosition(boxID);
+  const ExecutionState &state = _engines->getExecutionState();
+  std::map<TimeBoxId, float>::const_iterator it = state.positions.find(boxID);
+
+  return it != state.positions.end() ? it->second : 0.;
+}
+
+const ExecutionState &
+Maquette::getExecutionState()
+{
+  return _engines->getExecutionState();
+}
+
+void
+Maquette::processExecutionEvents()
+{
+  _engines->processExecutionEvents();
 }
 
 void
@@ -1589,7 +1636,7 @@ Maquette::turnExecutionOn(unsigned int boxId){
 bool
 Maquette::isExecutionOn()
 {
-    return _engines->isPlaying();
+    return _engines->getExecutionState().running;
 }
 
 void
@@ -1597,6 +1644,7 @@ Maquette::turnExecutionOff()
 {
     // Stop engine execution
     _engines->stop();
+    _engines->processExecutionEvents();
 
     // Set all boxes as if they crossed there end extremity
     BoxesMap::iterator it;
@@ -1629,7 +1677,7 @@ Maquette::resumeExecution()
 bool
 Maquette::isExecutionPaused()
 {
-  return _engines->isPaused();
+  return _engines->getExecutionState().paused;
 }
 
 void
@@ -1744,10 +1792,23 @@ Maquette::getNetworkHost()
   return _devices.at(_currentDevice).networkHost;
 }
 
-void
+bool
 Maquette::save(const string &fileName)
 {
-  _engines->store(fileName);
+  if (!_engines->store(fileName))
+    return false;
+  _projectFileName = fileName;
+
+  // store the discovered namespaces to not wait for the devices at the next loading
+  vector<string> deviceNames;
+  getNetworkDeviceNames(deviceNames);
+  for (vector<string>::iterator it = deviceNames.begin(); it != deviceNames.end(); ++it) {
+      string protocol;
+      if (!getDeviceProtocol(*it, protocol) && protocol == "Minuit") {
+          storeNetworkNamespaceCache(*it);
+        }
+    }
+  return true;
 }
 
 void
@@ -1764,9 +1825,20 @@ Maquette::load(const string &fileName)
     
     // Build the engine structure from the Xml file
     _engines->load(fileName);
+    _projectFileName = fileName;
+    
+    // Fill the namespace of the Minuit devices from their cache (they are revalidated in background below)
+    vector<string> deviceNames;
+    getNetworkDeviceNames(deviceNames);
+    for (vector<string>::iterator nameIt = deviceNames.begin(); nameIt != deviceNames.end(); ++nameIt) {
+        string protocol;
+        if (!getDeviceProtocol(*nameIt, protocol) && protocol == "Minuit")
+            _engines->loadNetworkNamespaceCache(*nameIt, namespaceCacheFile(*nameIt));
+    }
     
     // Reload networkTree
     _scene->editor()->networkTree()->load();
+    _scene->editor()->networkTree()->revalidateNamespaces();
     
     // Set zoom (for x axe only) and view center coordinates
     zoom = _engines->getViewZoom().x();
@@ -1775,44 +1847,28 @@ Maquette::load(const string &fileName)
     
     // BOXES
     {
-        vector<unsigned int>                        boxesID;
+        vector<BoxDescriptor>                       descriptors;
+        vector<BoxDescriptor>::iterator             descIt;
         unsigned int                                boxID, parentID;
-        string                                      name;
-        QColor                                      color;
-        unsigned int                                date, duration, topLeftY, sizeY;        
-        bool                                        muteState, loopState;
         
-        // get all boxes ID
-        _engines->getBoxesId(boxesID);
+        // get name, date, duration, topLeftY, sizeY and color informations of all boxes in one call
+        _engines->getBoxesDescriptors(descriptors);
         
-        for (it = boxesID.begin(); it != boxesID.end(); it++) {
-            
-            boxID = *it;
+        for (descIt = descriptors.begin(); descIt != descriptors.end(); descIt++) {
             
-            if (boxID == ROOT_BOX_ID)
-                continue;
+            boxID = descIt->id;
+            parentID = descIt->parentId;
             
-            // get name, date, duration, topLeftY, sizeY and color informations
-            name = _engines->getBoxName(boxID);
-            date = _engines->getBoxBeginTime(boxID);
-            duration = _engines->getBoxDuration(boxID);
-            topLeftY = _engines->getBoxVerticalPosition(boxID);
-            sizeY = _engines->getBoxVerticalSize(boxID);
-            color = _engines->getBoxColor(boxID);
-            parentID = _engines->getParentId(boxID);
-            muteState = _engines->getBoxMuteState(boxID);
-            loopState = _engines->isLoop(boxID);
-            
-            QPointF corner1(date / MaquetteScene::MS_PER_PIXEL, topLeftY);
-            QPointF corner2((date + duration) / MaquetteScene::MS_PER_PIXEL, topLeftY + sizeY);           
+            QPointF corner1(descIt->beginTime / MaquetteScene::MS_PER_PIXEL, descIt->verticalPosition);
+            QPointF corner2((descIt->beginTime + descIt->duration) / MaquetteScene::MS_PER_PIXEL, descIt->verticalPosition + descIt->verticalSize);
             
             ParentBox *newBox = new ParentBox(corner1, corner2, _scene);
                         
             newBox->setID(boxID);
-            newBox->setName(QString::fromStdString(name));
-            newBox->setColor(color);
-            newBox->setMuteState(muteState);
-            newBox->setLoopState(loopState);
+            newBox->setName(QString::fromStdString(descIt->name));
+            newBox->setColor(descIt->color);
+            newBox->setMuteState(descIt->muteState);
+            newBox->setLoopState(descIt->loopState);
 
             _boxes[boxID] = newBox;            
             _parentBoxes[boxID] = newBox;
@@ -2077,13 +2133,40 @@ Maquette::udpatePlayModeView(bool running)
 void
 triggerPointIsActiveCallback(unsigned int trgID, bool active)
 {
-	emit Maquette::getInstance()->triggerPointIsActiveSignal(trgID, active);
+	Maquette::getInstance()->updateTriggerPointActiveStatus(trgID, active);
 }
 
 void
 boxIsRunningCallback(unsigned int boxID, bool running)
 {
-	emit Maquette::getInstance()->boxIsRunningSignal(boxID, running);
+	Maquette::getInstance()->updateBoxRunningStatus(boxID, running);
+
+	if (boxID == ROOT_BOX_ID)
+		Maquette::getInstance()->udpatePlayModeView(running);
+}
+
+/// true if a transport message carries one number, whatever its type (an OSC client can send an int or a float)
+static bool
+isNumericTransportValue(const TTValue& value)
+{
+	if (value.size() != 1)
+		return false;
+
+	switch (value[0].type()) {
+		case kTypeFloat32:
+		case kTypeFloat64:
+		case kTypeInt8:
+		case kTypeUInt8:
+		case kTypeInt16:
+		case kTypeUInt16:
+		case kTypeInt32:
+		case kTypeUInt32:
+		case kTypeInt64:
+		case kTypeUInt64:
+			return true;
+		default:
+			return false;
+	}
 }
 
 void
@@ -2093,27 +2176,28 @@ transportCallback(TTSymbol& transport, const TTValue& value)
 
 	if (scene != nullptr) {
 
+		// queued to the GUI thread : it is the only reader of the execution state
 		if (transport == TTSymbol("Play"))
-			scene->playOrResume();
+			emit Maquette::getInstance()->playOrResumeSignal();
 
 		else if (transport == TTSymbol("Stop"))
-			scene->stopOrPause();
+			emit Maquette::getInstance()->stopOrPauseSignal();
 
 		else if (transport == TTSymbol("Pause"))
-			;
+			emit Maquette::getInstance()->pauseOrResumeSignal();
 
 		else if (transport == TTSymbol("Rewind"))
-			;
+			emit Maquette::getInstance()->rewindSignal();
 
 		else if (transport == TTSymbol("StartPoint"))
 		{
-			if (value.size() == 1 && value[0].type() == kTypeUInt32)
-				emit Maquette::getInstance()->changeTimeOffsetSignal(value[0]);
+			if (isNumericTransportValue(value))
+				emit Maquette::getInstance()->changeTimeOffsetSignal(TTUInt32(value[0]));
 		}
 		else if (transport == TTSymbol("Speed"))
 		{
-			if (value.size() == 1 && value[0].type() == kTypeFloat32)
-				emit Maquette::getInstance()->changeSpeedSignal(value[0]);
+			if (isNumericTransportValue(value))
+				emit Maquette::getInstance()->changeSpeedSignal(TTFloat64(value[0]));
 		}
 
 		scene->view()->emitPlayModeChanged();
@@ -2336,6 +2420,23 @@ Maquette::loadNetworkNamespace(const string &application, const string &filepath
     return _engines->loadNetworkNamespace(application,filepath);
 }
 
+void
+Maquette::storeNetworkNamespaceCache(const string &application){
+    if (!_projectFileName.empty())
+        _engines->storeNetworkNamespaceCache(application, namespaceCacheFile(application));
+}
+
+bool
+Maquette::isNetworkNamespaceCacheValid(const string &application){
+    return _engines->isNetworkNamespaceCacheValid(application);
+}
+
+string
+Maquette::namespaceCacheFile(const string &deviceName) const
+{
+    return _projectFileName + "." + deviceName + ".nscache";
+}
+
 int
 Maquette::appendToNetWorkNamespace(const std::string & address, const std::string & service, const std::string & type, const std::string & priority, const std::string & description, const std::string & range, const std::string & clipmode, const std::string & tags){
     return _engines->appendToNetWorkNamespace(address,service,type,priority,description,range,clipmode,tags);
@@ -2346,14 +2447,6 @@ Maquette::removeFromNetWorkNamespace(const std::string & address){
 	return _engines->removeFromNetWorkNamespace(address);
 }
 
-void Maquette::boxIsRunningSlot(unsigned int boxID, bool running)
-{
-  Maquette::getInstance()->updateBoxRunningStatus(boxID, running);
-
-  if(boxID==ROOT_BOX_ID)
-      Maquette::getInstance()->udpatePlayModeView(running);
-}
-
 
 std::vector<std::string> Maquette::getMIDIInputDevices()
 {
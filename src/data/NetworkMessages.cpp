@@ -153,7 +153,7 @@ NetworkMessages::computeMessage(const Message &msg)
 {
   //form : device/message/ value
 
-  QString completeMessage;
+  string completeMessage;
   string device = "";
   string message = "";
   string value = "";
@@ -164,14 +164,13 @@ NetworkMessages::computeMessage(const Message &msg)
 #endif
     }
 
-  completeMessage += QString::fromStdString(device);
-  completeMessage += QString::fromStdString(message);
-  completeMessage += QString::fromStdString(" ");
-  completeMessage += QString::fromStdString(value);
+  completeMessage.reserve(device.size() + message.size() + value.size() + 1);
+  completeMessage += device;
+  completeMessage += message;
+  completeMessage += " ";
+  completeMessage += value;
 
-
-
-  return completeMessage.toStdString();
+  return completeMessage;
 }
 
 QMap<QString, QString>
@@ -193,7 +192,6 @@ NetworkMessages::computeMessageWithoutValue(const Message &msg)
 {
   //form : device/message/
 
-  QString completeMessage;
   string device = "";
   string message = "";
   string value = "";
@@ -204,10 +202,23 @@ NetworkMessages::computeMessageWithoutValue(const Message &msg)
 #endif
     }
 
-  completeMessage += QString::fromStdString(device);
-  completeMessage += QString::fromStdString(message);
+  return device + message;
+}
+
+AddressId
+NetworkMessages::addressId(const Message &msg)
+{
+  string device = "";
+  string message = "";
+  string value = "";
+
+  if (!messageToString(msg, device, message, value)) {
+#ifdef DEBUG
+      std::cerr << "NetworkMessages::addressId : error while parsing message" << std::endl;
+#endif
+    }
 
-  return completeMessage.toStdString();
+  return AddressTable::getInstance().intern(device + message);
 }
 
 
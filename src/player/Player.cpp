@@ -0,0 +1,245 @@
+/*
+ * Headless player of the i-score projects
+ * Copyright © 2026, agent
+ *
+ * License: This code is licensed under the terms of the "CeCILL-C"
+ * http://www.cecill.info
+ *
+ * Usage : i-score-player [--quit-at-end] [--jamoma folder] [--export trace.csv | --export-binary trace.bin] project.score
+ *
+ * Loads a project with its devices then plays it without any window and logs
+ * the execution on the standard output. The execution is controlled remotely
+ * with the i-score transport messages (OSC port 13580) :
+ * /Transport/Play, /Transport/Stop, /Transport/Pause, /Transport/Rewind,
+ * /Transport/StartPoint <ms> and /Transport/Speed <factor>.
+ *
+ * With --export or --export-binary the project is not played : the messages written
+ * in its score are exported into a trace file, without the scheduler (see Engine::exportScore).
+ */
+
+#include "Engine.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <signal.h>
+#include <string>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+/** the period of the main loop : the boxes and trigger points are logged at this rate (in ms) */
+#define PLAYER_PERIOD 20
+
+/** a transport message received by the network thread, executed by the main loop */
+class TransportCommand {
+
+public:
+    TTSymbol    feature;
+    TTValue     value;
+};
+
+static Engine*                      engine = nullptr;
+static std::mutex                   commandsMutex;
+static std::condition_variable      commandsCondition;
+static std::deque<TransportCommand> commands;
+static volatile sig_atomic_t        quitRequested = 0;
+
+static void stopPlayer(int /*signal*/)
+{
+    quitRequested = 1;
+}
+
+static void triggerPointIsActive(ConditionedTimeBoxId triggerId, bool active)
+{
+    if (active)
+        printf("%8u ms : trigger point %u is waiting for %s\n", engine->getCurrentExecutionDate(), triggerId, engine->getTriggerPointMessage(triggerId).c_str());
+    else
+        printf("%8u ms : trigger point %u is not waiting\n", engine->getCurrentExecutionDate(), triggerId);
+}
+
+static void boxIsRunning(TimeBoxId boxId, bool running)
+{
+    if (boxId == ROOT_BOX_ID)
+        printf("%8u ms : the scenario %s\n", engine->getCurrentExecutionDate(), running ? "starts" : "ends");
+    else
+        printf("%8u ms : box %s %s\n", engine->getCurrentExecutionDate(), engine->getBoxName(boxId).c_str(), running ? "starts" : "ends");
+}
+
+static void transport(TTSymbol& feature, const TTValue& value)
+{
+    TransportCommand command;
+
+    command.feature = feature;
+    command.value = value;
+
+    // called by the network thread : the engine is only driven by the main loop
+    std::lock_guard<std::mutex> lock(commandsMutex);
+    commands.push_back(command);
+    commandsCondition.notify_one();
+}
+
+static void deviceNamespaceChanged(TTSymbol& deviceName)
+{
+    printf("the namespace of %s changed\n", deviceName.c_str());
+}
+
+static void deviceConnectionFailed(TTSymbol& deviceName, TTSymbol& error)
+{
+    fprintf(stderr, "can't connect %s : %s\n", deviceName.c_str(), error.c_str());
+}
+
+static void executeTransportCommand(const TransportCommand& command)
+{
+    printf("%8u ms : /Transport/%s\n", engine->getCurrentExecutionDate(), command.feature.c_str());
+
+    if (command.feature == TTSymbol("Play")) {
+
+        if (engine->isPaused())
+            engine->pause(false);
+        else if (!engine->isPlaying())
+            engine->play();
+    }
+    else if (command.feature == TTSymbol("Stop")) {
+
+        engine->stop();
+    }
+    else if (command.feature == TTSymbol("Pause")) {
+
+        if (engine->isPlaying())
+            engine->pause(!engine->isPaused());
+    }
+    else if (command.feature == TTSymbol("Rewind")) {
+
+        engine->stop();
+        engine->setTimeOffset(0);
+    }
+    else if (command.feature == TTSymbol("StartPoint")) {
+
+        if (command.value.size() == 1)
+            engine->setTimeOffset(TTUInt32(command.value[0]));
+    }
+    else if (command.feature == TTSymbol("Speed")) {
+
+        if (command.value.size() == 1)
+            engine->setExecutionSpeedFactor(TTFloat64(command.value[0]));
+    }
+}
+
+/** fill the namespace of the Minuit devices from the cache stored next to the project by i-score (if any) */
+static void loadNamespaceCaches(const std::string& project)
+{
+    std::vector<std::string> deviceNames;
+    std::string protocol;
+
+    engine->getNetworkDevicesName(deviceNames);
+
+    for (const std::string& deviceName : deviceNames) {
+
+        if (!engine->getDeviceProtocol(deviceName, protocol) && protocol == "Minuit") {
+
+            if (!engine->loadNetworkNamespaceCache(deviceName, project + "." + deviceName + ".nscache"))
+                printf("the namespace of %s is loaded from its cache\n", deviceName.c_str());
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::string project, jamomaFolder, tracePath;
+    TraceFormat traceFormat = TraceCSV;
+    bool        quitAtEnd = false;
+
+    for (int i = 1; i < argc; i++) {
+
+        if (!strcmp(argv[i], "--quit-at-end"))
+            quitAtEnd = true;
+        else if (!strcmp(argv[i], "--jamoma") && i + 1 < argc)
+            jamomaFolder = argv[++i];
+        else if (!strcmp(argv[i], "--export") && i + 1 < argc) {
+            tracePath = argv[++i];
+            traceFormat = TraceCSV;
+        }
+        else if (!strcmp(argv[i], "--export-binary") && i + 1 < argc) {
+            tracePath = argv[++i];
+            traceFormat = TraceBinary;
+        }
+        else
+            project = argv[i];
+    }
+
+    if (project.empty()) {
+        fprintf(stderr, "usage : %s [--quit-at-end] [--jamoma folder] [--export trace.csv | --export-binary trace.bin] project.score\n", argv[0]);
+        return 1;
+    }
+
+    // the log is read line by line (by a terminal or a supervisor)
+    setvbuf(stdout, NULL, _IOLBF, 0);
+
+    signal(SIGINT, stopPlayer);
+    signal(SIGTERM, stopPlayer);
+
+    engine = new Engine(&triggerPointIsActive, &boxIsRunning, &transport, &deviceNamespaceChanged, &deviceConnectionFailed, jamomaFolder);
+
+    if (engine->load(project) != 1) {
+        fprintf(stderr, "can't load %s\n", project.c_str());
+        delete engine;
+        return 1;
+    }
+
+    // nothing is sent to the devices : they don't need their namespace
+    if (!tracePath.empty()) {
+
+        TTUInt64 nbMessages;
+        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+        bool err = engine->exportScore(tracePath, traceFormat, nbMessages);
+
+        if (err)
+            fprintf(stderr, "can't write %s\n", tracePath.c_str());
+        else
+            printf("%llu messages exported into %s in %lld ms\n", (unsigned long long)nbMessages, tracePath.c_str(),
+                   (long long)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin).count());
+
+        delete engine;
+        return err ? 1 : 0;
+    }
+
+    loadNamespaceCaches(project);
+
+    printf("playing %s\n", project.c_str());
+    engine->play();
+
+    while (!quitRequested) {
+
+        std::deque<TransportCommand> received;
+
+        {
+            std::unique_lock<std::mutex> lock(commandsMutex);
+
+            if (commands.empty())
+                commandsCondition.wait_for(lock, std::chrono::milliseconds(PLAYER_PERIOD));
+
+            received.swap(commands);
+        }
+
+        for (const TransportCommand& command : received)
+            executeTransportCommand(command);
+
+        // log the boxes and trigger points notified by the scheduler
+        engine->processExecutionEvents();
+
+        if (quitAtEnd && !engine->getExecutionState().running)
+            break;
+    }
+
+    if (engine->isPlaying())
+        engine->stop();
+
+    engine->processExecutionEvents();
+
+    delete engine;
+
+    return 0;
+}
@@ -0,0 +1,158 @@
+/*
+ * Micro-benchmark and equivalence check of the CurveSampler
+ * Copyright © 2026, agent
+ *
+ * License: This code is licensed under the terms of the "CeCILL-C"
+ * http://www.cecill.info
+ *
+ * Usage : curve-sampler-benchmark [--jamoma folder] [nbCurves [sampleRate [duration]]]
+ *
+ * Samples nbCurves curves of duration seconds at sampleRate values per second
+ * with the Sample message of the Jamoma curves (the reference), point by point
+ * and by blocks with the CurveSampler. Prints the time spent by each one and
+ * checks the CurveSampler against the Jamoma curves : same number of values,
+ * same end points and the largest difference.
+ *
+ * Returns 1 if the CurveSampler doesn't match the Jamoma curves. The Engine
+ * makes the same check at run time on the first curves it samples and keeps
+ * the Jamoma curves after a mismatch (see Engine::isCurveSamplerChecked).
+ */
+
+#include "TTScore.h"
+#include "TTModular.h"
+#include "CurveSampler.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+/** the largest difference accepted between the CurveSampler and the Jamoma curves (values are sent as floats) */
+#define MAX_ERROR 1e-3
+
+typedef std::chrono::steady_clock Clock;
+
+static double elapsedMs(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+/** the number of values sent by a curve, as the Engine computes it */
+static unsigned int curveSamplesCount(unsigned int duration, unsigned int sampleRate)
+{
+    return std::max(2u, (unsigned int)((TTUInt64(duration) * sampleRate) / 1000) + 1);
+}
+
+int main(int argc, char* argv[])
+{
+    std::string jamomaFolder;
+    int i = 1;
+
+    if (argc > 2 && !strcmp(argv[1], "--jamoma")) {
+        jamomaFolder = argv[2];
+        i = 3;
+    }
+
+    unsigned int nbCurves = argc > i ? atoi(argv[i]) : 500;
+    unsigned int sampleRate = argc > i + 1 ? atoi(argv[i + 1]) : 1000;
+    unsigned int duration = (argc > i + 2 ? atoi(argv[i + 2]) : 10) * 1000;
+    unsigned int nbSamples = curveSamplesCount(duration, sampleRate);
+
+    std::vector<CurvePoints> curves(nbCurves);
+    std::vector<TTObject> jamomaCurves(nbCurves);
+    std::vector<std::vector<float> > references(nbCurves);
+    std::vector<float> scalar(nbSamples), output(nbSamples);
+    double jamomaMs, scalarMs, vectorizedMs, maxError = 0.;
+    unsigned int countMismatches = 0, endMismatches = 0;
+
+    TTModularInit(jamomaFolder.empty() ? NULL : jamomaFolder.c_str());
+    TTScoreInit(jamomaFolder.empty() ? NULL : jamomaFolder.c_str());
+
+    // curves with a few breakpoints as edited in a box (power 1. is linear)
+    srand(0);
+    for (unsigned int c = 0; c < nbCurves; c++) {
+
+        unsigned int nbPoints = 2 + rand() % 6;
+        TTValue parameters;
+
+        for (unsigned int j = 0; j < nbPoints; j++) {
+
+            float x = float(j) / (nbPoints - 1);
+            float coeff = 0.5f + float(rand()) / RAND_MAX;
+
+            curves[c].push_back(CurvePoint(x, float(rand() % 200) - 100.f, coeff * coeff * coeff * coeff));
+
+            // the functionParameters set by Engine::setCurveSections : x1 y1 b1 x2 y2 b2 ...
+            parameters.append(TTFloat64(curves[c].back().x));
+            parameters.append(TTFloat64(curves[c].back().y));
+            parameters.append(TTFloat64(curves[c].back().power));
+        }
+
+        jamomaCurves[c] = TTObject("Curve");
+        jamomaCurves[c].set("sampleRate", sampleRate);
+        jamomaCurves[c].set("functionParameters", parameters);
+    }
+
+    Clock::time_point start = Clock::now();
+    for (unsigned int c = 0; c < nbCurves; c++) {
+
+        TTValue values;
+
+        jamomaCurves[c].send("Sample", TTValue(TTUInt32(duration)), values);
+
+        references[c].resize(values.size());
+
+        for (TTUInt32 j = 0; j < values.size(); j++)
+            references[c][j] = TTFloat64(values[j]);
+    }
+    jamomaMs = elapsedMs(start);
+
+    start = Clock::now();
+    for (unsigned int c = 0; c < nbCurves; c++)
+        CurveSampler::sampleScalar(curves[c], scalar.data(), nbSamples);
+    scalarMs = elapsedMs(start);
+
+    start = Clock::now();
+    for (unsigned int c = 0; c < nbCurves; c++)
+        CurveSampler::sample(curves[c], output.data(), nbSamples);
+    vectorizedMs = elapsedMs(start);
+
+    // compare each curve with its Jamoma reference
+    for (unsigned int c = 0; c < nbCurves; c++) {
+
+        const std::vector<float>& reference = references[c];
+
+        CurveSampler::sample(curves[c], output.data(), nbSamples);
+
+        if (reference.size() != nbSamples) {
+            countMismatches++;
+            continue;
+        }
+
+        if (fabs(reference.front() - output.front()) > MAX_ERROR || fabs(reference.back() - output.back()) > MAX_ERROR)
+            endMismatches++;
+
+        for (unsigned int j = 0; j < nbSamples; j++)
+            maxError = fmax(maxError, fabs(reference[j] - output[j]));
+    }
+
+    printf("%u curves, %u samples each\n", nbCurves, nbSamples);
+    printf("jamoma     : %10.3f ms\n", jamomaMs);
+    printf("scalar     : %10.3f ms (x%.1f)\n", scalarMs, jamomaMs / scalarMs);
+    printf("%-10s : %10.3f ms (x%.1f)\n", CurveSampler::instructionSet(), vectorizedMs, jamomaMs / vectorizedMs);
+    printf("curves with another number of values : %u\n", countMismatches);
+    printf("curves with other end points         : %u\n", endMismatches);
+    printf("max error                            : %g\n", maxError);
+
+    if (countMismatches || endMismatches || maxError > MAX_ERROR) {
+        printf("the CurveSampler doesn't match the Jamoma curves\n");
+        return 1;
+    }
+
+    printf("the CurveSampler matches the Jamoma curves\n");
+    return 0;
+}